@@ -4,31 +4,64 @@
 
 # Add inputs and outputs from these tool invocations to the build variables 
 C_SRCS += \
+../access.c \
 ../buzzer.c \
+../config.c \
 ../control_main.c \
 ../dc_motor.c \
 ../external_eeprom.c \
 ../gpio.c \
+../internal_eeprom.c \
+../power.c \
+../profiler.c \
+../rtc.c \
+../scheduler.c \
+../storage.c \
+../sw_timer.c \
+../systick.c \
+../timeout.c \
 ../timer.c \
 ../twi.c \
 ../uart.c 
 
 OBJS += \
+./access.o \
 ./buzzer.o \
+./config.o \
 ./control_main.o \
 ./dc_motor.o \
 ./external_eeprom.o \
 ./gpio.o \
+./internal_eeprom.o \
+./power.o \
+./profiler.o \
+./rtc.o \
+./scheduler.o \
+./storage.o \
+./sw_timer.o \
+./systick.o \
+./timeout.o \
 ./timer.o \
 ./twi.o \
 ./uart.o 
 
 C_DEPS += \
+./access.d \
 ./buzzer.d \
+./config.d \
 ./control_main.d \
 ./dc_motor.d \
 ./external_eeprom.d \
 ./gpio.d \
+./internal_eeprom.d \
+./power.d \
+./profiler.d \
+./rtc.d \
+./scheduler.d \
+./storage.d \
+./sw_timer.d \
+./systick.d \
+./timeout.d \
 ./timer.d \
 ./twi.d \
 ./uart.d 
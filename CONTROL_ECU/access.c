@@ -0,0 +1,110 @@
+/******************************************************************************
+ *
+ * Module: Access windows
+ *
+ * File Name: access.c
+ *
+ * Description: Source file for the per-user weekly access windows.
+ *
+ * Date Created: 18/10/2026
+ *
+ * Author: Hazem Montasser
+ *
+ *******************************************************************************/
+
+#include "access.h"
+#include "storage.h"
+#include "system_modes.h"	/* SUCCESS/ERROR */
+
+/*******************************************************************************
+ *                         Global Variables(Private)                           *
+ *******************************************************************************/
+
+static Access_WindowType g_windows[ACCESS_USERS];
+static boolean g_always_open[ACCESS_USERS]; /* Every bit of the window is set */
+static boolean g_loaded[ACCESS_USERS]; /* Window read from the external tier */
+
+/*******************************************************************************
+ *                      Functions Definitions (Private)                        *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Refreshes the always open flag of a user, so a user without restrictions
+ * does not depend on the clock.
+ */
+static void access_refresh(uint8 a_user) {
+	const uint8 *hours = &g_windows[a_user].Hours[0][0];
+	g_always_open[a_user] = TRUE;
+	for (uint8 i = 0; i < sizeof(Access_WindowType); i++) {
+		if (hours[i] != 0xFF) {
+			g_always_open[a_user] = FALSE;
+			break;
+		}
+	}
+}
+
+/*
+ * Description :
+ * Loads the window of a user. Only erased cells (0xFF) read successfully mean
+ * no restriction: a failed read (bus error, marginal supply) denies every hour
+ * until a later load succeeds.
+ */
+static void access_load(uint8 a_user) {
+	uint8 *hours = &g_windows[a_user].Hours[0][0];
+	g_loaded[a_user] = (Storage_read(STORAGE_KEY_ACCESS_WINDOWS,
+			a_user * sizeof(Access_WindowType), hours,
+			sizeof(Access_WindowType)) == SUCCESS) ? TRUE : FALSE;
+	if (!g_loaded[a_user]) {
+		for (uint8 i = 0; i < sizeof(Access_WindowType); i++) {
+			hours[i] = 0x00;
+		}
+	}
+	access_refresh(a_user);
+}
+
+/*******************************************************************************
+ *                              Functions Definitions                          *
+ *******************************************************************************/
+
+void Access_init(void) {
+	for (uint8 user = 0; user < ACCESS_USERS; user++) {
+		access_load(user);
+	}
+}
+
+uint8 Access_setDay(uint8 a_user, uint8 a_weekday, uint32 a_hours) {
+	uint8 *day;
+	if (a_user >= ACCESS_USERS || a_weekday >= RTC_DAYS_PER_WEEK
+			|| a_hours > ACCESS_HOURS_ALL) {
+		return ERROR;
+	}
+	day = g_windows[a_user].Hours[a_weekday];
+	for (uint8 i = 0; i < ACCESS_DAY_BYTES; i++) {
+		day[i] = (uint8) (a_hours >> (8 * i));
+	}
+	access_refresh(a_user);
+	return Storage_write(STORAGE_KEY_ACCESS_WINDOWS,
+			a_user * sizeof(Access_WindowType) + a_weekday * ACCESS_DAY_BYTES,
+			day, ACCESS_DAY_BYTES);
+}
+
+boolean Access_isAllowed(uint8 a_user) {
+	RTC_TimeType now;
+	if (a_user >= ACCESS_USERS) {
+		return FALSE;
+	}
+	if (!g_loaded[a_user]) {
+		/* Retry the read which failed at startup */
+		access_load(a_user);
+	}
+	if (g_always_open[a_user]) {
+		return TRUE;
+	}
+	if (!RTC_isSet()) {
+		return FALSE;
+	}
+	RTC_getTime(&now);
+	return (g_windows[a_user].Hours[now.Weekday][now.Hour >> 3]
+			>> (now.Hour & 0x07)) & 0x01;
+}
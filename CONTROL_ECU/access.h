@@ -0,0 +1,110 @@
+/******************************************************************************
+ *
+ * Module: Access windows
+ *
+ * File Name: access.h
+ *
+ * Description: Header file for the per-user weekly access windows.
+ *
+ * 				Every user has one bit per hour of the week (7 x 24 bits = 21
+ * 				bytes), a set bit allows the user's password during that hour.
+ * 				The windows are kept in RAM and in the external storage tier, an
+ * 				erased EEPROM reads as all ones so a new device is always open.
+ * 				A window which can't be read denies every hour (fail closed).
+ *
+ * 				A user whose window is not always open is denied while the real
+ * 				time clock is not set (see rtc.h).
+ *
+ * Date Created: 18/10/2026
+ *
+ * Author: Hazem Montasser
+ *
+ *******************************************************************************/
+
+#ifndef ACCESS_H_
+#define ACCESS_H_
+
+#include "std_types.h"
+#include "rtc.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define ACCESS_USERS 			(1U)	/* One password is stored (user 0) */
+#define ACCESS_DAY_BYTES 		(3U)	/* 24 hour bits per day, bit 0 = 00:00-00:59 */
+#define ACCESS_HOURS_ALL 		(0x00FFFFFFUL)	/* Day mask of an always open day */
+
+/* Bytes reserved in the external tier for all windows */
+#define ACCESS_WINDOWS_SIZE \
+	(ACCESS_USERS * RTC_DAYS_PER_WEEK * ACCESS_DAY_BYTES)
+
+/*******************************************************************************
+ *                               Types Declaration                             *
+ *******************************************************************************/
+
+/******************************************************************************
+ *
+ * Structure Name: Access_WindowType
+ *
+ * Structure Description: Weekly window of one user, also its layout in the
+ * 		external tier.
+ *
+ *******************************************************************************/
+typedef struct {
+	uint8 Hours[RTC_DAYS_PER_WEEK][ACCESS_DAY_BYTES]; /* [weekday][hour / 8] bit (hour % 8) */
+} Access_WindowType;
+
+/*******************************************************************************
+ *                              Functions Prototypes                           *
+ *******************************************************************************/
+
+/******************************************************************************
+ *
+ * Function Name: Access_init
+ *
+ * Description: Loads the windows of every user from the external tier, users
+ * 		that cannot be read are denied and read again by Access_isAllowed.
+ * 		---Note: Storage_init must be called before this function.
+ *
+ *******************************************************************************/
+void Access_init(void);
+
+/******************************************************************************
+ *
+ * Function Name: Access_setDay
+ *
+ * Description: Replaces the window of one user on one day and queues its write.
+ *
+ * Args:
+ *
+ * 		[in] uint8 a_user
+ * 			User index, less than ACCESS_USERS.
+ * 			 uint8 a_weekday
+ * 			RTC_WeekdayType.
+ * 			 uint32 a_hours
+ * 			Allowed hours, bit n allows n:00-n:59 (ACCESS_HOURS_ALL = all day).
+ * 		[out] N/A
+ * Returns: uint8 (SUCCESS/ERROR)
+ *
+ *******************************************************************************/
+uint8 Access_setDay(uint8 a_user, uint8 a_weekday, uint32 a_hours);
+
+/******************************************************************************
+ *
+ * Function Name: Access_isAllowed
+ *
+ * Description: Returns whether the user is allowed at the current time: one
+ * 		bit lookup indexed by the clock weekday and hour.
+ *
+ * Args:
+ *
+ * 		[in] uint8 a_user
+ * 			User index, less than ACCESS_USERS.
+ * 		[out] N/A
+ * Returns: boolean
+ *
+ *******************************************************************************/
+boolean Access_isAllowed(uint8 a_user);
+
+#endif /* ACCESS_H_ */
@@ -16,20 +16,25 @@
 #include "gpio.h"
 #include <util/delay.h>
 
+/*******************************************************************************
+ *                          Pin Accessors (Private)                            *
+ *******************************************************************************/
+GPIO_DEFINE_PIN(buzzer, BUZZER_PORT, BUZZER_PIN);
+
 void Buzzer_init(void) {
-	GPIO_setupPinDirection(BUZZER_PORT, BUZZER_PIN, PIN_OUTPUT);
+	buzzer_output();
 }
 
 void Buzzer_pulse_ms(uint32 duration) {
-	GPIO_writePin(BUZZER_PORT, BUZZER_PIN, LOGIC_HIGH);
+	buzzer_high();
 	_delay_ms(duration);
-	GPIO_writePin(BUZZER_PORT, BUZZER_PIN, LOGIC_LOW);
+	buzzer_low();
 }
 
 void Buzzer_ON(void) {
-	GPIO_writePin(BUZZER_PORT, BUZZER_PIN, LOGIC_HIGH);
+	buzzer_high();
 }
 
 void Buzzer_OFF(void) {
-	GPIO_writePin(BUZZER_PORT, BUZZER_PIN, LOGIC_LOW);
+	buzzer_low();
 }
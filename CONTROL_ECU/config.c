@@ -0,0 +1,167 @@
+/******************************************************************************
+ *
+ * Module: Configuration store
+ *
+ * File Name: config.c
+ *
+ * Description: Source file for the typed key-value configuration store.
+ *
+ * Date Created: 18/10/2026
+ *
+ * Author: Hazem Montasser
+ *
+ *******************************************************************************/
+
+#include "config.h"
+#include "storage.h"
+#include "system_modes.h"	/* Default values */
+#include <stddef.h>			/* To use offsetof */
+
+/*******************************************************************************
+ *                               Types Declaration                             *
+ *******************************************************************************/
+
+/* Firmware description of a key: default value and accepted range */
+typedef struct {
+	uint8 Key;
+	uint8 Type;
+	uint16 Default;
+	uint16 Min;
+	uint16 Max; /* Min > Max marks a read-only key */
+} Config_DefaultType;
+
+/*******************************************************************************
+ *                         Global Variables(Private)                           *
+ *******************************************************************************/
+
+/* Defaults, MUST be sorted by key */
+static const Config_DefaultType g_defaults[] = {
+/*	 Key							Type			Default				Min	Max */
+	{ CONFIG_KEY_PASSWORD_LENGTH, CONFIG_TYPE_U8, PASSWORD_LENGTH - 2, 1, 0 },
+	{ CONFIG_KEY_MAX_PASSWORD_TRIES, CONFIG_TYPE_U8, MAX_PASSWORD_TRIES, 1, 10 },
+	{ CONFIG_KEY_DOOR_OPEN_SEC, CONFIG_TYPE_U8, 15, 1, 255 },
+	{ CONFIG_KEY_DOOR_HOLD_SEC, CONFIG_TYPE_U8, 3, 1, 255 },
+	{ CONFIG_KEY_DOOR_CLOSE_SEC, CONFIG_TYPE_U8, 15, 1, 255 },
+	{ CONFIG_KEY_ALARM_SEC, CONFIG_TYPE_U8, 60, 1, 255 } };
+
+#define CONFIG_NUM_KEYS (sizeof(g_defaults) / sizeof(g_defaults[0]))
+
+/* RAM copy of the index block, same order as g_defaults */
+static Config_EntryType g_index[CONFIG_NUM_KEYS];
+/* The EEPROM block was read (or rewritten) at startup and matches g_index */
+static boolean g_index_stored = FALSE;
+
+/*******************************************************************************
+ *                      Functions Definitions (Private)                        *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Binary search of a key in the RAM index, returns its position or
+ * CONFIG_NUM_KEYS if the key is unknown.
+ */
+static uint8 config_find(uint8 a_key) {
+	uint8 low = 0;
+	uint8 high = CONFIG_NUM_KEYS;
+	while (low < high) {
+		uint8 mid = (low + high) >> 1;
+		if (g_index[mid].Key == a_key) {
+			return mid;
+		} else if (g_index[mid].Key < a_key) {
+			low = mid + 1;
+		} else {
+			high = mid;
+		}
+	}
+	return CONFIG_NUM_KEYS;
+}
+
+/*
+ * Description :
+ * Queues the write of the whole index block.
+ */
+static void config_writeIndex(void) {
+	Config_HeaderType header = { CONFIG_MAGIC, CONFIG_NUM_KEYS };
+	Storage_write(STORAGE_KEY_CONFIG, 0, (const uint8*) &header,
+			sizeof(header));
+	Storage_write(STORAGE_KEY_CONFIG, sizeof(header), (const uint8*) g_index,
+			sizeof(g_index));
+}
+
+/*******************************************************************************
+ *                              Functions Definitions                          *
+ *******************************************************************************/
+
+void Config_init(void) {
+	Config_HeaderType header;
+	Config_EntryType entry;
+	uint8 pos;
+	boolean rewrite;
+
+	/* Firmware defaults first, so new keys always exist */
+	for (uint8 i = 0; i < CONFIG_NUM_KEYS; i++) {
+		g_index[i].Key = g_defaults[i].Key;
+		g_index[i].Type = g_defaults[i].Type;
+		g_index[i].Value = g_defaults[i].Default;
+	}
+
+	g_index_stored = FALSE;
+	/* Read failure (bus error, marginal supply): run on the defaults for this
+	 * boot and leave the stored values alone */
+	if (Storage_read(STORAGE_KEY_CONFIG, 0, (uint8*) &header, sizeof(header))
+			!= SUCCESS) {
+		return;
+	}
+	if ((header.Magic != CONFIG_MAGIC) || (header.Count > CONFIG_MAX_ENTRIES)) {
+		config_writeIndex();
+		g_index_stored = TRUE;
+		return;
+	}
+	/* Stored block written by another firmware version (other keys, order or
+	 * types): Config_set places entries by position, rewrite it sorted */
+	rewrite = (header.Count != CONFIG_NUM_KEYS) ? TRUE : FALSE;
+	/* Take stored values of known, writable keys of the same type */
+	for (uint8 i = 0; i < header.Count; i++) {
+		if (Storage_read(STORAGE_KEY_CONFIG,
+				sizeof(header) + i * sizeof(Config_EntryType), (uint8*) &entry,
+				sizeof(entry)) != SUCCESS) {
+			return;
+		}
+		if ((i >= CONFIG_NUM_KEYS) || (entry.Key != g_index[i].Key)
+				|| (entry.Type != g_index[i].Type)) {
+			rewrite = TRUE;
+		}
+		pos = config_find(entry.Key);
+		if ((pos < CONFIG_NUM_KEYS) && (entry.Type == g_index[pos].Type)
+				&& (entry.Value >= g_defaults[pos].Min)
+				&& (entry.Value <= g_defaults[pos].Max)) {
+			g_index[pos].Value = entry.Value;
+		}
+	}
+	if (rewrite) {
+		config_writeIndex();
+	}
+	g_index_stored = TRUE;
+}
+
+uint16 Config_get(uint8 a_key) {
+	uint8 pos = config_find(a_key);
+	return (pos < CONFIG_NUM_KEYS) ? g_index[pos].Value : 0;
+}
+
+uint8 Config_set(uint8 a_key, uint16 a_value) {
+	uint8 pos = config_find(a_key);
+	if ((pos >= CONFIG_NUM_KEYS) || (a_value < g_defaults[pos].Min)
+			|| (a_value > g_defaults[pos].Max)
+			|| ((g_index[pos].Type == CONFIG_TYPE_U8) && (a_value > 0xFF))
+			|| !g_index_stored) {
+		/* Unknown layout of the stored block: the entry can't be placed */
+		return ERROR;
+	}
+	g_index[pos].Value = a_value;
+	/* Only the value of this entry changes in EEPROM */
+	return Storage_write(STORAGE_KEY_CONFIG,
+			sizeof(Config_HeaderType) + pos * sizeof(Config_EntryType)
+					+ offsetof(Config_EntryType, Value),
+			(const uint8*) &g_index[pos].Value, sizeof(uint16));
+}
@@ -0,0 +1,138 @@
+/******************************************************************************
+ *
+ * Module: Configuration store
+ *
+ * File Name: config.h
+ *
+ * Description: Header file for the typed key-value configuration store.
+ * 				Tunables are kept in the external EEPROM as one index block:
+ * 				a header followed by entries sorted by key, each entry holding
+ * 				its key, type and value. The block is read once at startup and
+ * 				cached in RAM, so Config_get is a binary search without any
+ * 				bus access. Config_set updates the cache and queues the write
+ * 				of the changed entry only.
+ *
+ * Date Created: 18/10/2026
+ *
+ * Author: Hazem Montasser
+ *
+ *******************************************************************************/
+
+#ifndef CONFIG_H_
+#define CONFIG_H_
+
+#include "std_types.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define CONFIG_MAGIC 			(0xC5)	/* Marks a valid index block */
+#define CONFIG_MAX_ENTRIES 		(16U)	/* Entries reserved in the index block */
+
+/*******************************************************************************
+ *                               Types Declaration                             *
+ *******************************************************************************/
+
+/* Configuration keys, values are part of the link protocol and the EEPROM
+ * layout: never renumber, only append */
+typedef enum {
+	CONFIG_KEY_PASSWORD_LENGTH = 0x01, /* Read-only: password characters */
+	CONFIG_KEY_MAX_PASSWORD_TRIES = 0x02, /* Attempts before the alarm */
+	CONFIG_KEY_DOOR_OPEN_SEC = 0x10, /* Motor run time while opening */
+	CONFIG_KEY_DOOR_HOLD_SEC = 0x11, /* Time the door stays open */
+	CONFIG_KEY_DOOR_CLOSE_SEC = 0x12, /* Motor run time while closing */
+	CONFIG_KEY_ALARM_SEC = 0x13 /* Buzzer time in alarm mode */
+} Config_KeyType;
+
+/* Value types */
+typedef enum {
+	CONFIG_TYPE_U8, CONFIG_TYPE_U16
+} Config_ValueType;
+
+/******************************************************************************
+ *
+ * Structure Name: Config_EntryType
+ *
+ * Structure Description: One entry of the index block, same layout in RAM and
+ * 		in EEPROM (4 bytes).
+ *
+ *******************************************************************************/
+typedef struct {
+	uint8 Key; /* Config_KeyType */
+	uint8 Type; /* Config_ValueType */
+	uint16 Value;
+} Config_EntryType;
+
+/******************************************************************************
+ *
+ * Structure Name: Config_HeaderType
+ *
+ * Structure Description: Header of the index block in EEPROM.
+ *
+ *******************************************************************************/
+typedef struct {
+	uint8 Magic; /* CONFIG_MAGIC */
+	uint8 Count; /* Number of valid entries that follow */
+} Config_HeaderType;
+
+/* Size of the index block reserved in EEPROM */
+#define CONFIG_BLOCK_SIZE \
+	(sizeof(Config_HeaderType) + CONFIG_MAX_ENTRIES * sizeof(Config_EntryType))
+
+/*******************************************************************************
+ *                              Functions Prototypes                           *
+ *******************************************************************************/
+
+/******************************************************************************
+ *
+ * Function Name: Config_init
+ *
+ * Description: Builds the RAM index from the firmware defaults and overrides
+ * 		the values found in the EEPROM index block. If the block is missing or
+ * 		invalid the defaults are written to EEPROM. If it can't be read the
+ * 		defaults are used for this boot only and the EEPROM is left alone.
+ * 		---Note: Storage must be initialized before calling this function.
+ * Args: void
+ * Returns: void
+ *******************************************************************************/
+void Config_init(void);
+
+/******************************************************************************
+ *
+ * Function Name: Config_get
+ *
+ * Description: Returns the current value of a key, binary search in RAM.
+ * 		Unknown keys return 0.
+ *
+ * Args:
+ *
+ * 		[in] uint8 a_key
+ * 			Config_KeyType
+ * 		[out] N/A
+ * Returns: uint16
+ *
+ *******************************************************************************/
+uint16 Config_get(uint8 a_key);
+
+/******************************************************************************
+ *
+ * Function Name: Config_set
+ *
+ * Description: Changes the value of a key and queues the write of its entry.
+ * 		Fails for unknown or read-only keys, for values outside the limits
+ * 		of the key and if Config_init could not read the EEPROM block.
+ *
+ * Args:
+ *
+ * 		[in] uint8 a_key
+ * 			Config_KeyType
+ * 			 uint16 a_value
+ * 			New value
+ * 		[out] N/A
+ * Returns: uint8 (SUCCESS/ERROR)
+ *
+ *******************************************************************************/
+uint8 Config_set(uint8 a_key, uint16 a_value);
+
+#endif /* CONFIG_H_ */
@@ -16,13 +16,19 @@
 #define F_CPU (8000000UL)
 #include <avr/io.h>
 #include <avr/interrupt.h>	/* To use sei() */
-#include <math.h>			/* To use round() */
-#include <util/delay.h>
 
 /* Module headers */
-#include "timer.h"
+#include "systick.h"
+#include "scheduler.h"
+#include "profiler.h"
+#include "sw_timer.h"
 #include "twi.h"
 #include "external_eeprom.h"
+#include "power.h"
+#include "storage.h"
+#include "config.h"
+#include "rtc.h"
+#include "access.h"
 #include "uart.h"
 #include "dc_motor.h"
 #include "buzzer.h"
@@ -31,9 +37,47 @@
 /*******************************************************************************
  *                                      Definitions                            *
  *******************************************************************************/
-#define TIMER_TOP_VALUE 7812UL				/* Timer compare top value used for delays of min time = 1s*/
-#define TIMER_PRESCALER_VALUE (1024.0)		/* Decimal value of timer pre-scaler used in calculations of delay*/
-#define EEPROM_PASSWORD_ADDRESS (0x0320)	/* Address in EEPROM where password will be stored*/
+/* Tasks, the ID is the priority (0 = highest) */
+#define TASK_LINK 				(0U)	/* Parses bytes received from HMI ECU */
+#define TASK_TIMERS 			(1U)	/* Runs expired software timers (door motor) */
+#define TASK_ALARM 				(2U)	/* Ends the alarm */
+#define TASK_STORAGE 			(3U)	/* Drains the EEPROM write queue */
+
+/* Task events */
+#define EVENT_RX 				(0x01)	/* TASK_LINK: byte received */
+#define EVENT_EXPIRED 			(0x01)	/* TASK_TIMERS: software timer expired */
+#define EVENT_POWER_FAIL 		(0x01)	/* TASK_STORAGE: supply became marginal */
+#define EVENT_CLOCK_SAVE 		(0x02)	/* TASK_STORAGE: clock save period elapsed */
+
+#define ALARM_PERIOD_MS 		(100U)	/* Alarm deadline check period */
+#define STORAGE_PERIOD_MS 		(1U)	/* Write queue step period */
+#define CLOCK_SAVE_PERIOD_MIN 	(60U)	/* Clock save period, ~11 years of EEPROM endurance */
+
+#define ACCESS_USER_PASSWORD 	(0U)	/* Access window user of the stored password */
+
+#define CONFIG_FRAME_SIZE 		(3U)	/* Key, value LSB, value MSB */
+#define CLOCK_FRAME_SIZE 		(4U)	/* RTC_TimeType */
+#define ACCESS_FRAME_SIZE 		(5U)	/* User, weekday, hours mask LSB..MSB */
+#define LINK_FRAME_SIZE 		(5U)	/* Largest of the frames above */
+
+/*******************************************************************************
+ *                               Types Declaration                             *
+ *******************************************************************************/
+/* Door sequence steps, advanced by timer expiry */
+typedef enum {
+	DOOR_IDLE, DOOR_OPENING, DOOR_HOLDING, DOOR_CLOSING
+} Door_StateType;
+
+/* What the next bytes from HMI ECU are */
+typedef enum {
+	LINK_IDLE, /* Waiting for SYNC */
+	LINK_REQUEST, /* Main menu request byte */
+	LINK_PASSWORD, /* Password characters up to UART_EOS */
+	LINK_CONFIG, /* Configuration change frame */
+	LINK_CLOCK, /* Clock set frame */
+	LINK_ACCESS /* Access window frame */
+} Link_StateType;
+
 /*******************************************************************************
  *                            Global Variables (Private)			           *
  *******************************************************************************/
@@ -41,65 +85,125 @@ static uint8 g_password[PASSWORD_LENGTH] = { 0 }; /* Contains final password */
 static uint8 g_pass_buffer1[PASSWORD_LENGTH] = { 0 }; /* Buffer for password entry #1*/
 static uint8 g_pass_buffer2[PASSWORD_LENGTH] = { 0 }; /* Buffer for password entry #2*/
 static uint8 HMI_status = MODE_FIRST_BOOT; /* Application status for HMI ECU*/
-static uint8 timer_ticks = 0; /* Timer ticks delay_over is set to TRUE */
-static uint8 delay_over = FALSE; /* Used to check if timer delay is over by the application*/
+static Door_StateType g_door_state = DOOR_IDLE; /* Current step of the door sequence */
+static boolean g_alarm_on = FALSE; /* Buzzer is sounding */
+static SwTimer_DeadlineType g_alarm_deadline; /* End of the alarm */
+static uint32 g_swtimer_last_ms = 0; /* System tick time of the last SwTimer_tick */
+static boolean g_storage_active = TRUE; /* Storage task is periodic */
+static Link_StateType g_link_state = LINK_IDLE; /* Receive state */
+static uint8 g_link_index = 0; /* Bytes received in the current frame */
+static uint8 g_link_frame[LINK_FRAME_SIZE]; /* Configuration, clock or access window frame */
+static boolean g_first_entry_received = FALSE; /* First boot: entry #1 is in g_pass_buffer1 */
+static boolean g_attempt_active = FALSE; /* Passwords received are attempts */
+static uint8 g_attempt_count = 0; /* Failed attempts so far */
+static uint8 g_attempt_success_state = MODE_NORMAL_BOOT_MAIN; /* Mode after a correct attempt */
+static uint8 g_request = 0; /* Request being confirmed by the attempts */
 /*******************************************************************************
  *               Application Callback Functions Definitions     		       *
  *******************************************************************************/
 
 /*
  * Description :
- * Callback function for Timer delay interrupt.
+ * Callback function for the system tick, runs the software timers every
+ * SWTIMER_TICK_MS milliseconds. After a tickless sleep it catches up on all
+ * the software timer ticks slept through.
  */
-void Control_Delay_Callback(void) {
-	static uint8 tick = 0;
-	/* Increment ticks every interrupt until it equals specified ticks */
-	if (tick == timer_ticks) {
-		/* Reset tick since it's static variable */
-		tick = 0;
-		/* Set flag when ticks are over to end the delay*/
-		delay_over = TRUE;
-	} else {
-		++tick;
+void Control_SysTick_Callback(void) {
+	uint32 now = SysTick_getMillis();
+	while ((uint32) (now - g_swtimer_last_ms) >= SWTIMER_TICK_MS) {
+		g_swtimer_last_ms += SWTIMER_TICK_MS;
+		if (SwTimer_tick()) {
+			Sched_setEvent(TASK_TIMERS, EVENT_EXPIRED);
+		}
+	}
+	if (RTC_update(now)
+			&& (RTC_getMinuteOfWeek() % CLOCK_SAVE_PERIOD_MIN) == 0) {
+		Sched_setEvent(TASK_STORAGE, EVENT_CLOCK_SAVE);
 	}
 }
 
-/*******************************************************************************
- *                           Functions Definitions (Private)      		       *
- *******************************************************************************/
+/*
+ * Description :
+ * UART receive interrupt callback, wakes the link task.
+ */
+void Control_Rx_Callback(void) {
+	Sched_setEvent(TASK_LINK, EVENT_RX);
+}
+
+void Control_Door_Callback(void);
 
 /*
  * Description :
- * Delay function of minimum delay of 1s
+ * Schedules the next step of the door sequence. If the timer pool is
+ * exhausted the motor is stopped rather than left running with nothing to end
+ * it, the abort is logged and the HMI is sent the handshakes it still waits
+ * for (locking, then closed) so it leaves the door screens.
  */
-static void delay_sec(uint8 a_sec) {
-	/* Ttimer = 1/(FCPU/Prescaler)
-	 *
-	 * Tdelay = (Prescaler/FCPU) * no. of ticks * compare_value
-	 * */
-	/* Calculate no. of timer ticks needed for a particular delay of 's' seconds,
-	 * round the result to avoid getting 0 ticks when it yields 0.99 */
-	timer_ticks = (float) round(
-			((a_sec / ((TIMER_PRESCALER_VALUE / F_CPU) * TIMER_TOP_VALUE))));
+static void door_after(uint32 a_ms) {
+	if (SwTimer_after(a_ms, Control_Door_Callback) != NULL_PTR) {
+		return;
+	}
+	DcMotor_Rotate(STOP);
+	Storage_logEvent(AUDIT_EVENT_DOOR_ABORTED, g_door_state);
+	if (g_door_state != DOOR_CLOSING) {
+		UART_sendByte(SYNC_HANDSHAKE);
+	}
+	UART_sendByte(SYNC_HANDSHAKE);
+	g_door_state = DOOR_IDLE;
+}
 
-	/* Reset timer value before starting */
-	Timer_resetTimerValue(TIMER1_ID);
-	/* Start timer count */
-	Timer_resume(TIMER1_ID);
-	/* Poll for flag */
-	while (!delay_over)
-		;
-	/* Stop timer */
-	Timer_stop(TIMER1_ID);
-	/* Reset flag for next delay */
-	delay_over = FALSE;
+/*
+ * Description :
+ * Callback function for the door timer, moves the door sequence one step:
+ * opening (CW) -> holding -> closing (ACW) -> idle.
+ */
+void Control_Door_Callback(void) {
+	switch (g_door_state) {
+	case DOOR_OPENING:
+		/* Door open, hold it */
+		DcMotor_Rotate(STOP);
+		g_door_state = DOOR_HOLDING;
+		door_after(Config_get(CONFIG_KEY_DOOR_HOLD_SEC) * 1000UL);
+		break;
+	case DOOR_HOLDING:
+		/* Notify HMI ECU to print locking message*/
+		UART_sendByte(SYNC_HANDSHAKE);
+		DcMotor_Rotate(ACW);
+		g_door_state = DOOR_CLOSING;
+		door_after(Config_get(CONFIG_KEY_DOOR_CLOSE_SEC) * 1000UL);
+		break;
+	case DOOR_CLOSING:
+		DcMotor_Rotate(STOP);
+		g_door_state = DOOR_IDLE;
+		/* Notify HMI ECU that door is closed to proceed */
+		UART_sendByte(SYNC_HANDSHAKE);
+		break;
+	default:
+		break;
+	}
+}
 
+/*
+ * Description :
+ * Callback function for the supply monitor interrupt, switches the storage
+ * queue to (or back from) the power-fail flush.
+ */
+void Control_Power_Callback(void) {
+	Storage_setSupplyMarginal(Power_isSupplyMarginal());
+	Sched_setEvent(TASK_STORAGE, EVENT_POWER_FAIL);
 }
+
+/*******************************************************************************
+ *                           Functions Definitions (Private)      		       *
+ *******************************************************************************/
+
 /*
  * Description :
  * Compares 2 passwords and returns true if they match exactly, false if otherwise.
  */
 static boolean pass_compare(const uint8 *a_arr1, const uint8 *a_arr2) {
+	boolean match = TRUE;
+	PROFILE_BEGIN(PROBE_PASS_COMPARE);
 	/* Loop on PASSWORD_LENGTH - 2 elements in array
 	 * Last 2 characters are UART end of string and null terminator
 	 * characters.
@@ -107,58 +211,339 @@ static boolean pass_compare(const uint8 *a_arr1, const uint8 *a_arr2) {
 	for (uint8 i = 0; i < PASSWORD_LENGTH - 2; i++) {
 		/* Any element not matching the other returns false*/
 		if (a_arr1[i] != a_arr2[i]) {
-			return FALSE;
+			match = FALSE;
+			break;
 		}
 	}
+	PROFILE_END(PROBE_PASS_COMPARE);
 	/* Array contents match exactly */
-	return TRUE;
+	return match;
 }
 /*
  * Description :
- * Copies given array into global password variable and writes it in EEPROM.
+ * Copies given array into global password variable and queues its write to EEPROM.
+ * Returns immediately, the write is drained while waiting for the HMI.
  */
 static void set_password(const uint8 *a_arr) {
 	for (uint8 i = 0; i < PASSWORD_LENGTH - 2; i++) {
 		g_password[i] = a_arr[i];
 	}
-	EEPROM_writeString(EEPROM_PASSWORD_ADDRESS, g_password,
-	PASSWORD_LENGTH-2);
+	Storage_write(STORAGE_KEY_PASSWORD, 0, g_password, PASSWORD_LENGTH - 2);
+	Storage_logEvent(AUDIT_EVENT_PASSWORD_SET, 0);
 }
 /*
  * Description :
- * Confirms password attempts that the user enters through HMI.
+ * Opens the door: rotates the motor clockwise, the rest of the sequence runs
+ * from Control_Door_Callback.
+ */
+static void door_open(void) {
+	Storage_logEvent(AUDIT_EVENT_DOOR_OPENED, 0);
+	DcMotor_Rotate(CW);
+	g_door_state = DOOR_OPENING;
+	door_after(Config_get(CONFIG_KEY_DOOR_OPEN_SEC) * 1000UL);
+}
+/*
+ * Description :
+ * Starts the buzzer, the alarm task ends it.
+ */
+static void alarm_start(void) {
+	Buzzer_ON();
+	g_alarm_on = TRUE;
+	SwTimer_deadlineSet(&g_alarm_deadline,
+			Config_get(CONFIG_KEY_ALARM_SEC) * 1000UL);
+	Sched_setPeriod(TASK_ALARM, ALARM_PERIOD_MS);
+}
+/*
+ * Description :
+ * Starts taking the next passwords as attempts to confirm a request.
+ */
+static void start_attempts(uint8 a_desired_success_state, uint8 a_request) {
+	g_attempt_active = TRUE;
+	g_attempt_count = 0;
+	g_attempt_success_state = a_desired_success_state;
+	g_request = a_request;
+}
+/*
+ * Description :
+ * Checks one password attempt that the user entered through HMI.
  * If user enters maximum number of tries incorrectly, change mode to alarm.
- * If user enters the password correctly, change mode to given success state.
+ * If user enters the password correctly, change mode to the success state.
+ * A correct password outside the access window ends the attempts, the request
+ * is denied.
+ *
+ * UART_SENDS# = 2
+ * UART_REC#   = 0
+ */
+static void check_attempt(void) {
+	uint8 max_tries = Config_get(CONFIG_KEY_MAX_PASSWORD_TRIES);
+	boolean match = pass_compare(g_pass_buffer2, g_password);
+	if (match && !Access_isAllowed(ACCESS_USER_PASSWORD)) {
+		/* Password correct outside the user's access window: deny the
+		 * request without counting a failed attempt */
+		g_attempt_active = FALSE;
+		Storage_logEvent(AUDIT_EVENT_ACCESS_DENIED, g_request);
+		if (g_request != 0) {
+			HMI_status = MODE_NORMAL_BOOT_MAIN;
+		}
+		UART_sendByte(ERROR);
+		UART_sendByte(HMI_status);
+	} else if (match) {
+		/* Password correct, go to success state */
+		g_attempt_active = FALSE;
+		HMI_status = g_attempt_success_state;
+		UART_sendByte(SUCCESS);
+		UART_sendByte(HMI_status);
+		if (g_request == OPEN_DOOR_REQUEST) {
+			door_open();
+		} else if (g_request == CONFIG_SET_REQUEST) {
+			/* Authenticated, the frame of the request follows */
+			g_link_state = LINK_CONFIG;
+			g_link_index = 0;
+		} else if (g_request == RTC_SET_REQUEST) {
+			g_link_state = LINK_CLOCK;
+			g_link_index = 0;
+		} else if (g_request == ACCESS_SET_REQUEST) {
+			g_link_state = LINK_ACCESS;
+			g_link_index = 0;
+		}
+	} else if (++g_attempt_count < max_tries) {
+		/* Password incorrect, attempt another try */
+		Storage_logEvent(AUDIT_EVENT_ATTEMPT_FAILED, g_attempt_count);
+		HMI_status = MODE_NORMAL_BOOT_LOCKED;
+		UART_sendByte(ERROR);
+		UART_sendByte(HMI_status);
+	} else {
+		/* Last attempt failed, trigger the alarm */
+		g_attempt_active = FALSE;
+		Storage_logEvent(AUDIT_EVENT_ALARM, max_tries);
+		HMI_status = MODE_ALARM_MODE;
+		UART_sendByte(ERROR);
+		UART_sendByte(HMI_status);
+		alarm_start();
+	}
+}
+/*
+ * Description :
+ * Handles a complete password received in g_pass_buffer2, either an attempt
+ * or one of the two first boot entries.
  *
  * UART_SENDS# = 2
- * UART_REC#   = 2
+ * UART_REC#   = 0
  */
-static boolean confirmPasswordAttempts(uint8 a_desired_success_state) {
-	/* Loop 3 times for 3 password attempts,
-	 *  3rd password attempt results in the alarm triggering*/
-	for (uint8 i = 0; i < MAX_PASSWORD_TRIES; i++) {
-		while (UART_receiveByte() != SYNC_HANDSHAKE)
-			;
-		UART_receiveString(g_pass_buffer1);
-		/* Password correct, exit loop to success state*/
-		if (pass_compare(g_pass_buffer1, g_password)) {
-			HMI_status = a_desired_success_state;
+static void on_password_received(void) {
+	if (!g_attempt_active && HMI_status == MODE_NORMAL_BOOT_LOCKED) {
+		start_attempts(MODE_NORMAL_BOOT_MAIN, 0);
+	}
+	if (g_attempt_active) {
+		check_attempt();
+	} else if (HMI_status == MODE_FIRST_BOOT) {
+		if (!g_first_entry_received) {
+			/* Keep entry #1, wait for entry #2 */
+			for (uint8 i = 0; i < PASSWORD_LENGTH; i++) {
+				g_pass_buffer1[i] = g_pass_buffer2[i];
+			}
+			g_first_entry_received = TRUE;
+			return;
+		}
+		g_first_entry_received = FALSE;
+		/* Compare both passwords,
+		 * store in EEPROM if match,
+		 * re-try if no match*/
+		if (pass_compare(g_pass_buffer1, g_pass_buffer2)) {
+			set_password(g_pass_buffer1);
+			UART_sendByte(SYNC_HANDSHAKE);
 			UART_sendByte(SUCCESS);
-			UART_sendByte(HMI_status);
-			return TRUE;
-		} else if (i < MAX_PASSWORD_TRIES - 1) {
-			/* Password incorrect for 1st & 2nd time (i=0,1),
-			 * attempt another try*/
-			HMI_status = MODE_NORMAL_BOOT_LOCKED;
+			/* Barrier: new password must be durable before leaving first boot */
+			Storage_flush();
+			HMI_status = MODE_NORMAL_BOOT_MAIN;
+		} else {
+			UART_sendByte(SYNC_HANDSHAKE);
 			UART_sendByte(ERROR);
-			UART_sendByte(HMI_status);
 		}
 	}
-	/* This part is reached ONLY after 3 failed attempts */
-	HMI_status = MODE_ALARM_MODE;
-	UART_sendByte(ERROR);
-	UART_sendByte(HMI_status);
-	return FALSE;
+}
+/*
+ * Description :
+ * Handles one byte received from HMI ECU.
+ * Every frame starts with SYNC, followed by a request byte in main menu mode
+ * or by a password string otherwise.
+ */
+static void on_byte_received(uint8 a_byte) {
+	uint8 status;
+	switch (g_link_state) {
+	case LINK_IDLE:
+		/* Nothing is expected while the door moves or the alarm sounds */
+		if (a_byte != SYNC_HANDSHAKE || g_door_state != DOOR_IDLE || g_alarm_on) {
+			break;
+		}
+		if (HMI_status == MODE_NORMAL_BOOT_MAIN && !g_attempt_active) {
+			g_link_state = LINK_REQUEST;
+		} else {
+			g_link_state = LINK_PASSWORD;
+			g_link_index = 0;
+		}
+		break;
+	case LINK_REQUEST:
+		g_link_state = LINK_IDLE;
+		if (a_byte == OPEN_DOOR_REQUEST) {
+			/* User wants to open the door (pressed '+' key),
+			 * request old password first*/
+			start_attempts(MODE_NORMAL_BOOT_MAIN, a_byte);
+		} else if (a_byte == PROFILE_DUMP_REQUEST) {
+			/* Debug: send the length-prefixed profiler table. Only reached
+			 * from the main menu with the door idle and no alarm, so nothing
+			 * else is on the link. Without the profiler the request is dropped */
+#if (PROFILER_ENABLE == TRUE)
+			UART_sendByte(SYNC_HANDSHAKE);
+			Profiler_dump(UART_sendByte);
+#endif
+		} else if (a_byte == CONFIG_SET_REQUEST || a_byte == RTC_SET_REQUEST
+				|| a_byte == ACCESS_SET_REQUEST) {
+			/* Configuration, clock or access window change: request the
+			 * password first, check_attempt then takes the frame */
+			start_attempts(MODE_NORMAL_BOOT_MAIN, a_byte);
+		} else {
+			/* User wants to change password (pressed '-' key,
+			 * request old password first*/
+			start_attempts(MODE_FIRST_BOOT, a_byte);
+		}
+		break;
+	case LINK_PASSWORD:
+		if (a_byte == UART_EOS) {
+			/* Add null terminator to string*/
+			g_pass_buffer2[g_link_index] = '\0';
+			g_link_state = LINK_IDLE;
+			on_password_received();
+		} else if (g_link_index < PASSWORD_LENGTH - 1) {
+			g_pass_buffer2[g_link_index++] = a_byte;
+		}
+		break;
+	case LINK_CONFIG:
+		g_link_frame[g_link_index++] = a_byte;
+		if (g_link_index == CONFIG_FRAME_SIZE) {
+			g_link_state = LINK_IDLE;
+			UART_sendByte(SYNC_HANDSHAKE);
+			UART_sendByte(
+					Config_set(g_link_frame[0],
+							g_link_frame[1] | ((uint16) g_link_frame[2] << 8)));
+		}
+		break;
+	case LINK_CLOCK:
+		g_link_frame[g_link_index++] = a_byte;
+		if (g_link_index == CLOCK_FRAME_SIZE) {
+			g_link_state = LINK_IDLE;
+			status = RTC_setTime((const RTC_TimeType*) g_link_frame);
+			if (status == SUCCESS) {
+				Storage_saveClock(RTC_getMinuteOfWeek());
+			}
+			UART_sendByte(SYNC_HANDSHAKE);
+			UART_sendByte(status);
+		}
+		break;
+	case LINK_ACCESS:
+		g_link_frame[g_link_index++] = a_byte;
+		if (g_link_index == ACCESS_FRAME_SIZE) {
+			g_link_state = LINK_IDLE;
+			UART_sendByte(SYNC_HANDSHAKE);
+			UART_sendByte(
+					Access_setDay(g_link_frame[0], g_link_frame[1],
+							g_link_frame[2] | ((uint32) g_link_frame[3] << 8)
+									| ((uint32) g_link_frame[4] << 16)));
+		}
+		break;
+	}
+}
+
+/*******************************************************************************
+ *                              Tasks Definitions                              *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Link task: handles every byte buffered by the UART.
+ */
+static void link_task(uint8 a_events) {
+	uint8 byte;
+	while (UART_tryReceiveByte(&byte)) {
+		on_byte_received(byte);
+	}
+}
+/*
+ * Description :
+ * Timers task: runs the callbacks of expired software timers.
+ */
+static void timers_task(uint8 a_events) {
+	SwTimer_dispatch();
+}
+/*
+ * Description :
+ * Alarm task: turns the buzzer off once the alarm duration is over and
+ * returns to main menu mode.
+ *
+ * UART_SENDS# = 2
+ */
+static void alarm_task(uint8 a_events) {
+	if (g_alarm_on && SwTimer_deadlineExpired(&g_alarm_deadline)) {
+		Buzzer_OFF();
+		g_alarm_on = FALSE;
+		Sched_setPeriod(TASK_ALARM, 0);
+		/* Return to main menu options */
+		HMI_status = MODE_NORMAL_BOOT_MAIN;
+		/* Notify HMI ECU of new status*/
+		UART_sendByte(SYNC_HANDSHAKE);
+		UART_sendByte(HMI_status);
+	}
+}
+/*
+ * Description :
+ * Storage task: one step of the EEPROM write queue per period, the power-fail
+ * flush runs inside Storage_service as soon as the supply is marginal.
+ * Every CLOCK_SAVE_PERIOD_MIN the clock is saved in the boot record.
+ */
+static void storage_task(uint8 a_events) {
+	if (a_events & EVENT_CLOCK_SAVE) {
+		Storage_saveClock(RTC_getMinuteOfWeek());
+	}
+	if (Storage_pending() != 0) {
+		Storage_service();
+	} else {
+		/* Queue drained: stop polling, the idle hook re-arms the task */
+		Sched_setPeriod(TASK_STORAGE, 0);
+		g_storage_active = FALSE;
+	}
+}
+/*
+ * Description :
+ * Scheduler idle hook (tickless idle): sleeps until the next task release,
+ * software timer expiry or interrupt (UART RX, supply monitor).
+ */
+static void idle_hook(void) {
+	uint32 idle_ms;
+	sint32 timer_ms;
+	uint16 ticks;
+
+	/* Records queued by the last task step: resume the storage task */
+	if (!g_storage_active && Storage_pending() != 0) {
+		Sched_setPeriod(TASK_STORAGE, STORAGE_PERIOD_MS);
+		g_storage_active = TRUE;
+	}
+	idle_ms = Sched_getIdleTime();
+	ticks = SwTimer_getNextTicks();
+	if (ticks != SWTIMER_NO_TIMER) {
+		timer_ms = (sint32) ((uint32) ticks * SWTIMER_TICK_MS
+				- (SysTick_getMillis() - g_swtimer_last_ms));
+		if (timer_ms <= 0) {
+			idle_ms = 0;
+		} else if ((uint32) timer_ms < idle_ms) {
+			idle_ms = timer_ms;
+		}
+	}
+	cli();
+	if (Sched_isIdle()) {
+		SysTick_sleepFor(idle_ms);
+	} else {
+		sei();
+	}
 }
 
 int main(void) {
@@ -172,18 +557,6 @@ int main(void) {
 	 * */
 	TWI_ConfigType TWI_CONFIG = { 400000, 0x02, TWI_F_CPU_1 };
 
-	/*
-	 * Timer init:
-	 * 	Timer used = Timer1
-	 * 	Pre-scaler clock = F_CPU/1024
-	 * 	Mode = Compare mode (CTC)
-	 * 	Compare value = 7812 (gives one interrupt every 1s for every compare match)
-	 * 	Interrupt on compare match = TRUE for enabled
-	 * */
-	Timer_ConfigType TIMER_CONFIG = { TIMER1_ID, FCPU_1024_T01,
-			Timer_Mode_Compare, 7812,
-			TRUE };
-
 	/*
 	 * UART init:
 	 * 	Baudrate = 9600
@@ -193,95 +566,34 @@ int main(void) {
 	 * */
 	UART_ConfigType conf = {9600,{0,PARITY_DISABLED,UART_CH_SIZE_8}};
 
+	/* Latch the reset cause first and start the supply monitor */
+	Power_init();
+	Profiler_init();
+	Power_setCallback(Control_Power_Callback);
 	/* Modules initialization */
 	UART_init(&conf);
 	Buzzer_init();
 	DcMotor_Init();
 	TWI_init(&TWI_CONFIG);
-	/* Set callback timer function and stop timer initially */
-	Timer_setCallback(TIMER1_ID, Control_Delay_Callback);
-	Timer_init(&TIMER_CONFIG);
-	Timer_stop(TIMER1_ID);
-	Timer_resetTimerValue(TIMER1_ID);
-	/* Enable global interrupts */
+	/* 1ms system tick on Timer2, drives the software timer service */
+	SwTimer_init();
+	SysTick_setCallback(Control_SysTick_Callback);
+	SysTick_init();
+	Sched_init();
+	UART_setRXCallback_Notif(Control_Rx_Callback);
+	/* Enable global interrupts: the clock must run for the EEPROM deadlines */
 	sei();
-	/*Super loop*/
-	for (;;) {
-		switch (HMI_status) {
-
-		/************************** First boot, setting up new password  **************************/
-		case MODE_FIRST_BOOT:
-			/*Synchronize before receiving first password */
-			while (UART_receiveByte() != SYNC_HANDSHAKE) {
-			}
-			UART_receiveString(g_pass_buffer1);
-			/*Synchronize before receiving first password */
-			while (UART_receiveByte() != SYNC_HANDSHAKE) {
-			}
-			UART_receiveString(g_pass_buffer2);
-			/* Compare both passwords,
-			 * store in EEPROM if match,
-			 * re-try if no match*/
-			if (pass_compare(g_pass_buffer1, g_pass_buffer2)) {
-				UART_sendByte(SYNC_HANDSHAKE);
-				UART_sendByte(SUCCESS);
-				HMI_status = MODE_NORMAL_BOOT_MAIN;
-				set_password(g_pass_buffer1);
-
-			} else {
-				UART_sendByte(SYNC_HANDSHAKE);
-				UART_sendByte(ERROR);
-			}
-			break;
-			/*********************** Mode for password attempts by the user ***********************/
-		case MODE_NORMAL_BOOT_LOCKED:
-			confirmPasswordAttempts(MODE_NORMAL_BOOT_MAIN);
-			break;
-		case MODE_NORMAL_BOOT_MAIN:
-			/* User wants to open the door (pressed '+' key),
-			 * request old password first*/
-			while (UART_receiveByte() != SYNC_HANDSHAKE)
-				;
-			if (UART_receiveByte() == OPEN_DOOR_REQUEST) {
-				if (confirmPasswordAttempts(MODE_NORMAL_BOOT_MAIN)) {
-					/* Rotate motor for 15s clockwise (Opening door)*/
-					DcMotor_Rotate(CW);
-					delay_sec(15);
-					/* Wait for 10s */
-					DcMotor_Rotate(STOP);
-					delay_sec(3);
-
-					/* Notify HMI ECU to print locking message*/
-					UART_sendByte(SYNC_HANDSHAKE);
-					/* Rotate motor for 15s anti-clockwise (Closing door)*/
-					DcMotor_Rotate(ACW);
-					delay_sec(15);
-
-					DcMotor_Rotate(STOP);
-					/* Notify HMI ECU that door is closed to proceed */
-					UART_sendByte(SYNC_HANDSHAKE);
-				}
-			}
-			/* User wants to change password (pressed '-' key,
-			 * request old password first*/
-			else {
-				confirmPasswordAttempts(MODE_FIRST_BOOT);
-			}
-			break;
-			/******** Alarm mode triggered by wrong password entry, turn on buzzer for 60s ********/
-		case MODE_ALARM_MODE:
-			/* Start buzzer for 60s */
-			Buzzer_ON();
-			delay_sec(60);
-			Buzzer_OFF();
-			/* Return to main menu options */
-			HMI_status = MODE_NORMAL_BOOT_MAIN;
-			/* Notify HMI ECU of new status*/
-			UART_sendByte(SYNC_HANDSHAKE);
-			UART_sendByte(HMI_status);
-
-			break;
-		}
-
-	}
+	/* Load the boot record with the cause of this reset */
+	Storage_init(Power_getResetFlags());
+	Config_init();
+	/* Resume the clock from the last save, load the access windows */
+	RTC_init(Storage_getBootRecord()->Clock);
+	Access_init();
+	/* Tasks */
+	Sched_addTask(TASK_LINK, link_task, 0);
+	Sched_addTask(TASK_TIMERS, timers_task, 0);
+	Sched_addTask(TASK_ALARM, alarm_task, 0);
+	Sched_addTask(TASK_STORAGE, storage_task, STORAGE_PERIOD_MS);
+	Sched_setIdleCallback(idle_hook);
+	Sched_start();
 }
@@ -14,8 +14,33 @@
 
 #include "dc_motor.h"
 #include "common_macros.h"
-#include <avr/io.h>
+
+/*******************************************************************************
+ *                          Pin Accessors (Private)                            *
+ *******************************************************************************/
+GPIO_DEFINE_PIN(dcmotor_ena, DCMOTOR_PORT_PWM, DCMOTOR_ENA_PIN);
+GPIO_DEFINE_PIN(dcmotor_in1, DCMOTOR_PORT_CTRL, DCMOTOR_IN1_PIN);
+GPIO_DEFINE_PIN(dcmotor_in2, DCMOTOR_PORT_CTRL, DCMOTOR_IN2_PIN);
+
+#if (DCMOTOR_PORT_PWM == DCMOTOR_PORT_CTRL)
+/* ENA, IN1 & IN2 share a port: they change in one atomic write */
+#define DCMOTOR_PINS_MASK \
+	((1 << DCMOTOR_ENA_PIN) | (1 << DCMOTOR_IN1_PIN) | (1 << DCMOTOR_IN2_PIN))
+#endif
+
 #ifdef PWM_MODE
+#include "timer.h"
+#include "power.h"	/* For POWER_MONITOR_ENABLE */
+
+/* Timer0 PWM only comes out on OC0 */
+#if (DCMOTOR_PORT_PWM != PORTB_ID) || (DCMOTOR_ENA_PIN != PIN3_ID)
+#error "PWM_MODE needs ENA on OC0 (PB3): DCMOTOR_PORT_PWM/DCMOTOR_ENA_PIN"
+#endif
+/* PB3 is also AIN1, the divided supply input of the supply monitor */
+#if (POWER_MONITOR_ENABLE == TRUE)
+#error "PWM_MODE drives PB3 (AIN1): set POWER_MONITOR_ENABLE to FALSE"
+#endif
+
 /*******************************************************************************
  *                          Global Variables                                   *
  *******************************************************************************/
@@ -25,45 +50,72 @@ volatile uint8 g_DCMotor_current_speed = 0;
  *******************************************************************************/
 
 void PWM_Timer0_Start(uint8 duty_cycle) {
-	TCNT0 = 0;
-	TCCR0 = 0;
 	/*
-	 * WGM0:1 = 1 ---> Fast PWM mode
-	 * COM01  = 1 ---> Non-inverting PWM mode
-	 * CS01   = 1 ---> Pre-scaler = FCPU/8
-	 *
+	 * Timer init:
+	 * 	Timer used = Timer0
+	 * 	Pre-scaler clock = F_CPU/8
+	 * 	Mode = Fast PWM, non-inverting on OC0
+	 * 	Compare value = duty cycle out of TIMER0_TOP_VALUE
 	 * */
-	OCR0 = (uint8) (((float) duty_cycle / 100.0) * (TIMER0_TOP_VALUE));
-	TCCR0 = (1 << WGM00) | (1 << WGM01) | (1 << COM01) | (1 << CS01);
+	Timer_ConfigType TIMER_CONFIG = { TIMER0_ID, FCPU_8_T01, Timer_Mode_FastPWM,
+			(((uint16) duty_cycle * (TIMER0_TOP_VALUE)) / 100), FALSE, 0,
+			Timer_Output_Clear, Timer_Output_Disconnected };
+
+	Timer_init(&TIMER_CONFIG);
+	g_DCMotor_current_speed = duty_cycle;
 }
 #endif
 void DcMotor_Init(void) {
 	/* Setup control pins */
-	GPIO_setupPinDirection(DCMOTOR_PORT_PWM, DCMOTOR_ENA_PIN, PIN_OUTPUT);
-	GPIO_setupPinDirection(DCMOTOR_PORT_CTRL, DCMOTOR_IN1_PIN, PIN_OUTPUT);
-	GPIO_setupPinDirection(DCMOTOR_PORT_CTRL, DCMOTOR_IN2_PIN, PIN_OUTPUT);
+	dcmotor_ena_output();
+	dcmotor_in1_output();
+	dcmotor_in2_output();
 	/* Turn off motor initially */
-	GPIO_writePin(DCMOTOR_PORT_PWM, DCMOTOR_ENA_PIN, LOGIC_LOW);
-	GPIO_writePin(DCMOTOR_PORT_CTRL, DCMOTOR_IN1_PIN, LOGIC_LOW);
-	GPIO_writePin(DCMOTOR_PORT_CTRL, DCMOTOR_IN2_PIN, LOGIC_LOW);
+#ifdef DCMOTOR_PINS_MASK
+	GPIO_writePinsAtomic(DCMOTOR_PORT_CTRL, 0, DCMOTOR_PINS_MASK);
+#else
+	dcmotor_ena_low();
+	dcmotor_in1_low();
+	dcmotor_in2_low();
+#endif
 }
 #ifdef PWM_MODE
 void DcMotor_Rotate(DcMotor_State state,uint8 speed) {
 #else
 void DcMotor_Rotate(DcMotor_State state) {
 #endif
-	/* Set rotation direction on IN1, IN2 pins*/
-	GPIO_writePin(DCMOTOR_PORT_CTRL, DCMOTOR_IN1_PIN, (state & 0x01) >> 0);
-	GPIO_writePin(DCMOTOR_PORT_CTRL, DCMOTOR_IN2_PIN, (state & 0x02) >> 1);
-
+	/* ENA level, in PWM_MODE OC0 drives ENA while the motor runs */
+	uint8 ena = LOGIC_LOW;
+#ifdef PWM_MODE
 	if (state == STOP) {
-		GPIO_writePin(DCMOTOR_ENA_PIN, DCMOTOR_ENA_PIN, LOGIC_LOW);
+		/* Release OC0 so the pin goes back to GPIO control */
+		Timer_DeInit(TIMER0_ID);
+		g_DCMotor_current_speed = 0;
+	}
+#else
+	if (state != STOP) {
+		ena = LOGIC_HIGH;
+	}
+#endif
 
-	} else {
-#ifdef PWM_MODE
-		PWM_Timer0_Start(speed);
+#ifdef DCMOTOR_PINS_MASK
+	/* Rotation direction on IN1, IN2 and ENA in a single write, the H-bridge
+	 * never sees an intermediate state */
+	GPIO_writePortMasked(DCMOTOR_PORT_CTRL, DCMOTOR_PINS_MASK,
+			(((state & 0x01) >> 0) << DCMOTOR_IN1_PIN)
+					| (((state & 0x02) >> 1) << DCMOTOR_IN2_PIN)
+					| (ena << DCMOTOR_ENA_PIN));
 #else
-		GPIO_writePin(DCMOTOR_PORT_PWM, DCMOTOR_ENA_PIN, LOGIC_HIGH);
+	/* Separate ports: disable the bridge while the direction changes */
+	dcmotor_ena_low();
+	dcmotor_in1_write((state & 0x01) >> 0);
+	dcmotor_in2_write((state & 0x02) >> 1);
+	dcmotor_ena_write(ena);
 #endif
+
+#ifdef PWM_MODE
+	if (state != STOP) {
+		PWM_Timer0_Start(speed);
 	}
+#endif
 }
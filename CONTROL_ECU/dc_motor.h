@@ -23,7 +23,7 @@
 /* Define PWM_MODE if needed, otherwise output will always be 100% duty cycle */
 /*#define PWM_MODE*/
 
-#define DCMOTOR_PORT_PWM PORTB_ID	/* Port which has ENA connected: MUST HAVE AN OC PIN */
+#define DCMOTOR_PORT_PWM PORTB_ID	/* Port which has ENA connected: PWM_MODE needs ENA on OC0 (PB3), shared with the supply monitor (checked in dc_motor.c) */
 #define DCMOTOR_PORT_CTRL PORTB_ID	/* Port which has IN1&IN2 connected */
 
 #define DCMOTOR_ENA_PIN PIN5_ID
@@ -14,98 +14,193 @@
 
 #include "external_eeprom.h"
 #include "twi.h"
+#include "timeout.h"
+#include "profiler.h"
 
 /*******************************************************************************
- *                          Functions Definitions                              *
+ *                      Functions Definitions (Private)                        *
  *******************************************************************************/
 
-uint8 EEPROM_writeByte(uint16 a_addr, uint8 a_data) {
+/*
+ * Description :
+ * Sends start, slave address with R/W = 0 and the lower address byte.
+ * Returns EEPROM_BUSY if the EEPROM NACKs its address (write cycle running).
+ * On any failure the bus is released with a stop bit. A bus timeout leaves
+ * TWI_NO_INFO as status, so it fails the status checks like any bus error.
+ */
+static uint8 EEPROM_addressFrame(uint16 a_addr,
+		const Timeout_DeadlineType *a_deadline) {
 	/* Send start bit */
-	TWI_start();
+	TWI_start(a_deadline);
 	if (TWI_getStatus() != TWI_MT_START) {
+		TWI_stop(a_deadline);
 		return ERROR;
 	}
 
-	/* Mask the slave address of EEPROM with the last 3 bits of	 * the memory address (A8,A9,A10) with R/W = 0 for write request*/
-
-	uint8 slave_w_3addr = EEPROM_SLAVE_ADDRESS | ((a_addr & 0x0700) >> 7);
-
-	TWI_writeByte((uint8) slave_w_3addr);
-
-	if (TWI_getStatus() != TWI_MT_SLA_W_ACK) {
+	/* Mask the slave address of EEPROM with the last 3 bits of
+	 * the memory address (A8,A9,A10) with R/W = 0 for write request*/
+	TWI_writeByte((uint8) (EEPROM_SLAVE_ADDRESS | ((a_addr & 0x0700) >> 7)),
+			a_deadline);
+	if (TWI_getStatus() == TWI_MT_SLA_W_NACK) {
+		TWI_stop(a_deadline);
+		return EEPROM_BUSY;
+	} else if (TWI_getStatus() != TWI_MT_SLA_W_ACK) {
+		TWI_stop(a_deadline);
 		return ERROR;
 	}
+
 	/* Send the rest of the address and await ACK*/
-	TWI_writeByte((uint8) a_addr);
+	TWI_writeByte((uint8) a_addr, a_deadline);
 	if (TWI_getStatus() != TWI_MT_DATA_ACK) {
+		TWI_stop(a_deadline);
 		return ERROR;
 	}
-	/* Send the data and await ACK*/
-	TWI_writeByte((uint8) a_data);
-	if (TWI_getStatus() != TWI_MT_DATA_ACK) {
-		return ERROR;
+	return SUCCESS;
+}
+
+/*
+ * Description :
+ * Acknowledge polling: waits until the EEPROM finishes its write cycle, at most
+ * EEPROM_WRITE_CYCLE_MS.
+ */
+static uint8 EEPROM_waitReady(void) {
+	Timeout_DeadlineType deadline;
+	Timeout_start(&deadline, EEPROM_WRITE_CYCLE_MS);
+	while (!EEPROM_isReady()) {
+		if (Timeout_check(&deadline, TIMEOUT_SITE_EEPROM_READY)
+				!= TIMEOUT_STATUS_OK) {
+			return ERROR;
+		}
 	}
-	/* End of frame */
-	TWI_stop();
 	return SUCCESS;
 }
+
+/*******************************************************************************
+ *                          Functions Definitions                              *
+ *******************************************************************************/
+
+uint8 EEPROM_writeByte(uint16 a_addr, uint8 a_data) {
+	return EEPROM_writeString(a_addr, &a_data, 1);
+}
+
 uint8 EEPROM_readByte(uint16 a_addr, uint8 *a_data) {
-	/* Send start bit */
-	TWI_start();
-	if (TWI_getStatus() != TWI_MT_START) {
+	return EEPROM_readString(a_addr, a_data, 1);
+}
+
+uint8 EEPROM_writePage(uint16 a_addr, const uint8 *a_data, uint8 a_size) {
+	Timeout_DeadlineType deadline;
+	uint8 status;
+	/* Reject empty writes and writes that would wrap inside the page */
+	if ((a_size == 0)
+			|| ((a_addr % EEPROM_PAGE_SIZE) + a_size > EEPROM_PAGE_SIZE)) {
+		return ERROR;
+	}
+	Timeout_start(&deadline, EEPROM_TIMEOUT_MS);
+	status = EEPROM_addressFrame(a_addr, &deadline);
+	if (status != SUCCESS) {
+		return status;
+	}
+	/* Send the data and await ACK for each byte*/
+	for (uint8 i = 0; i < a_size; i++) {
+		TWI_writeByte(a_data[i], &deadline);
+		if (TWI_getStatus() != TWI_MT_DATA_ACK) {
+			TWI_stop(&deadline);
+			return ERROR;
+		}
+	}
+	/* End of frame, starts the internal write cycle */
+	if (TWI_stop(&deadline) != TIMEOUT_STATUS_OK) {
 		return ERROR;
 	}
+	return SUCCESS;
+}
 
-	/* Mask the slave address of EEPROM with the last 3 bits of
-	 * the memory address (A8,A9,A10) with R/W = 0 for write request*/
-	uint8 slave_w_3addr = EEPROM_SLAVE_ADDRESS | ((a_addr & 0x0700) >> 7);
+boolean EEPROM_isReady(void) {
+	Timeout_DeadlineType deadline;
+	boolean ready;
+	Timeout_start(&deadline, EEPROM_TIMEOUT_MS);
+	TWI_start(&deadline);
+	if (TWI_getStatus() != TWI_MT_START) {
+		TWI_stop(&deadline);
+		return FALSE;
+	}
+	/* EEPROM does not ACK its address during the internal write cycle */
+	TWI_writeByte(EEPROM_SLAVE_ADDRESS, &deadline);
+	ready = (TWI_getStatus() == TWI_MT_SLA_W_ACK) ? TRUE : FALSE;
+	if (TWI_stop(&deadline) != TIMEOUT_STATUS_OK) {
+		ready = FALSE;
+	}
+	return ready;
+}
 
-	TWI_writeByte((uint8) slave_w_3addr);
+uint8 EEPROM_writeString(uint16 a_addr, const uint8 *str, uint8 size) {
+	uint8 chunk;
+	uint8 status = SUCCESS;
+	PROFILE_BEGIN(PROBE_EEPROM_WRITE_STRING);
+	/* Write page by page, each chunk ends at the next page boundary */
+	while (size > 0) {
+		chunk = EEPROM_PAGE_SIZE - (a_addr % EEPROM_PAGE_SIZE);
+		if (chunk > size) {
+			chunk = size;
+		}
+		if (!EEPROM_waitReady()
+				|| (EEPROM_writePage(a_addr, str, chunk) != SUCCESS)) {
+			status = ERROR;
+			break;
+		}
+		a_addr += chunk;
+		str += chunk;
+		size -= chunk;
+	}
+	PROFILE_END(PROBE_EEPROM_WRITE_STRING);
+	return status;
+}
 
-	if (TWI_getStatus() != TWI_MT_SLA_W_ACK) {
+uint8 EEPROM_readString(uint16 a_addr, uint8 *str, uint8 size) {
+	Timeout_DeadlineType deadline;
+	if (size == 0) {
+		return SUCCESS;
+	}
+	/* A previous write may still be programming */
+	if (!EEPROM_waitReady()) {
 		return ERROR;
 	}
-	/* Send the rest of the address and await ACK*/
-	TWI_writeByte((uint8) a_addr);
-
-	if (TWI_getStatus() != TWI_MT_DATA_ACK) {
+	/* Whole sequential read in one frame: ~25us per byte at 400Kb/s */
+	Timeout_start(&deadline, EEPROM_TIMEOUT_MS + (size >> 5));
+	if (EEPROM_addressFrame(a_addr, &deadline) != SUCCESS) {
 		return ERROR;
 	}
 	/* Send repeated start */
-	TWI_start();
+	TWI_start(&deadline);
 	if (TWI_getStatus() != TWI_MT_REP_START) {
+		TWI_stop(&deadline);
 		return ERROR;
 	}
 	/* Send slave address with R/W = 1 for read request and await ACK*/
-	TWI_writeByte((uint8) (slave_w_3addr | 0x01));
+	TWI_writeByte(
+			(uint8) (EEPROM_SLAVE_ADDRESS | ((a_addr & 0x0700) >> 7) | 0x01),
+			&deadline);
 	if (TWI_getStatus() != TWI_MT_SLA_R_ACK) {
+		TWI_stop(&deadline);
 		return ERROR;
 	}
-	/* Receive data in a_data without ACK to terminate the frame*/
-	*a_data = TWI_readByteWithNack();
+	/* Sequential read: ACK every byte except the last one which is NACKed
+	 * to terminate the frame */
+	for (uint8 i = 0; i < size - 1; i++) {
+		TWI_readByteWithAck(&str[i], &deadline);
+		if (TWI_getStatus() != TWI_MR_DATA_ACK) {
+			TWI_stop(&deadline);
+			return ERROR;
+		}
+	}
+	TWI_readByteWithNack(&str[size - 1], &deadline);
 	if (TWI_getStatus() != TWI_MR_DATA_NACK) {
+		TWI_stop(&deadline);
 		return ERROR;
 	}
 	/* End of frame */
-	TWI_stop();
-	return SUCCESS;
-}
-
-uint8 EEPROM_writeString(uint16 a_addr, const uint8 *str, uint8 size) {
-	/* Write (size-1) bytes to EEPROM, return if any error occurs */
-	for (uint8 i = 0; i < size; i++) {
-		if(!EEPROM_writeByte(a_addr + i, str[i])){
-			return ERROR;
-		}
-	}
-	return SUCCESS;
-}
-uint8 EEPROM_readString(uint16 a_addr, uint8 *str, uint8 size) {
-	/* Read (size-1) bytes to EEPROM, return if any error occurs */
-	for (uint8 i = 0; i < size; i++) {
-		if(!EEPROM_readByte(a_addr + i,&str[i])){
-			return ERROR;
-		}
+	if (TWI_stop(&deadline) != TIMEOUT_STATUS_OK) {
+		return ERROR;
 	}
 	return SUCCESS;
 }
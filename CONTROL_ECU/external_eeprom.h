@@ -23,7 +23,11 @@
 
 #define ERROR 				 (0x00)
 #define SUCCESS 			 (0x01)
+#define EEPROM_BUSY 		 (0x02)	/* EEPROM NACKed its address: internal write cycle running */
 #define EEPROM_SLAVE_ADDRESS (0xA0)	/* EEPROM's slave address used to communicate with EEPROM*/
+#define EEPROM_PAGE_SIZE 	 (16U)	/* M24C16 page write buffer size */
+#define EEPROM_TIMEOUT_MS 	 (5U)	/* Bus time allowed per frame (~0.5ms for a full page at 400Kb/s)*/
+#define EEPROM_WRITE_CYCLE_MS (10U)	/* Max wait for a write cycle to end (tW = 5ms)*/
 
 /*******************************************************************************
  *                            Functions Prototypes                             *
@@ -66,11 +70,48 @@ uint8 EEPROM_writeByte(uint16 a_addr, uint8 a_data);
  *******************************************************************************/
 uint8 EEPROM_readByte(uint16 a_addr, uint8 *a_data);
 
+/******************************************************************************
+ *
+ * Function Name: EEPROM_writePage
+ *
+ * Description:  Writes up to EEPROM_PAGE_SIZE bytes in a single frame, the
+ * 		EEPROM programs all of them in one internal write cycle.
+ * 		Does not wait for a previous write cycle: if the EEPROM is still busy
+ * 		EEPROM_BUSY is returned immediately and nothing is written.
+ * 		---Note: The bytes must not cross a page boundary, otherwise ERROR is
+ * 				 returned (the EEPROM would wrap to the start of the page).
+ * Args:
+ *
+ * 		[in] uint16 a_addr
+ * 				To store the 10-bit address
+ * 			 const uint8 *a_data
+ * 			 	Bytes to store
+ * 			 uint8 a_size
+ * 			 	Number of bytes (1 - EEPROM_PAGE_SIZE)
+ * 		[out] N/A
+ * Returns: uint8 (SUCCESS/ERROR/EEPROM_BUSY)
+ *
+ *******************************************************************************/
+uint8 EEPROM_writePage(uint16 a_addr, const uint8 *a_data, uint8 a_size);
+
+/******************************************************************************
+ *
+ * Function Name: EEPROM_isReady
+ *
+ * Description:  Polls the EEPROM address once, returns TRUE if it ACKs,
+ * 		i.e. no internal write cycle is running. FALSE also on a bus timeout.
+ * Args: void
+ * Returns: boolean
+ *
+ *******************************************************************************/
+boolean EEPROM_isReady(void);
+
 /******************************************************************************
  *
  * Function Name: EEPROM_writeString
  *
  * Description:  Writes an array of bytes to a specific address in EEPROM.
+ * 		Bytes are written page by page, waiting for each write cycle to end.
  *		---Note: If an error occurs during writing process, the data will be
  *				 partially stored inside EEPROM.
  * Args:
@@ -0,0 +1,198 @@
+/******************************************************************************
+ *
+ * Module: TWI / I2C - Host M24C16 simulator
+ *
+ * File Name: bench.c
+ *
+ * Description: Host bench comparing the external EEPROM write strategies on
+ * 				the simulated M24C16: throughput, write amplification and wear.
+ *
+ * 				gcc -I. -Ihost external_eeprom.c timeout.c
+ * 					host/twi_m24c16_sim.c host/bench.c
+ * 				./a.out [directory of the backing files]
+ *
+ * 				Every strategy stores the same stream of records, one backing
+ * 				file each, so the wear columns only count its own writes:
+ *
+ * 					byte	EEPROM_writeByte for every byte of a fixed slot
+ * 					page	EEPROM_writeString of a fixed slot (page chunks)
+ * 					update	read back first, write only when the record changed
+ * 					ring	EEPROM_writeString rotating over BENCH_RING_SLOTS slots
+ *
+ * Date Created: 18/10/2026
+ *
+ * Author: Hazem Montasser
+ *
+ *******************************************************************************/
+
+#include "external_eeprom.h"
+#include "twi.h"
+#include "twi_m24c16_sim.h"
+#include "systick.h"
+#include <stdio.h>
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define BENCH_RECORDS 		(256U)	/* Records stored by every strategy */
+#define BENCH_RECORD_SIZE 	(12U)	/* Bytes per record */
+#define BENCH_CHANGE_EVERY 	(4U)	/* The record content changes every N stores */
+#define BENCH_SLOT_ADDR 	(0x10CU)/* Fixed slot, straddles a page boundary */
+#define BENCH_RING_ADDR 	(0x400U)/* First slot of the ring */
+#define BENCH_RING_SLOTS 	(32U)	/* Slots of the ring */
+#define BENCH_BITRATE 		(400000UL)
+
+/*******************************************************************************
+ *                               Types Declaration                             *
+ *******************************************************************************/
+
+typedef uint8 (*Bench_StoreType)(uint16 a_index, const uint8 *a_record);
+
+typedef struct {
+	const char *Name;
+	Bench_StoreType Store;
+} Bench_StrategyType;
+
+/*******************************************************************************
+ *                      Functions Definitions (Target shims)                   *
+ *******************************************************************************/
+
+/* The driver deadlines run on the virtual clock of the simulator */
+uint32 SysTick_getMillis(void) {
+	return (uint32) (M24C16_SIM_getTimeNs() / 1000000ULL);
+}
+
+/*******************************************************************************
+ *                      Functions Definitions (Strategies)                     *
+ *******************************************************************************/
+
+static uint8 bench_storeByte(uint16 a_index, const uint8 *a_record) {
+	(void) a_index;
+	for (uint8 i = 0; i < BENCH_RECORD_SIZE; i++) {
+		if (EEPROM_writeByte(BENCH_SLOT_ADDR + i, a_record[i]) != SUCCESS) {
+			return ERROR;
+		}
+	}
+	return SUCCESS;
+}
+
+static uint8 bench_storePage(uint16 a_index, const uint8 *a_record) {
+	(void) a_index;
+	return EEPROM_writeString(BENCH_SLOT_ADDR, a_record, BENCH_RECORD_SIZE);
+}
+
+static uint8 bench_storeUpdate(uint16 a_index, const uint8 *a_record) {
+	uint8 stored[BENCH_RECORD_SIZE];
+	uint8 i;
+	(void) a_index;
+	if (EEPROM_readString(BENCH_SLOT_ADDR, stored, BENCH_RECORD_SIZE)
+			!= SUCCESS) {
+		return ERROR;
+	}
+	for (i = 0; i < BENCH_RECORD_SIZE; i++) {
+		if (stored[i] != a_record[i]) {
+			return EEPROM_writeString(BENCH_SLOT_ADDR, a_record,
+					BENCH_RECORD_SIZE);
+		}
+	}
+	return SUCCESS;
+}
+
+static uint8 bench_storeRing(uint16 a_index, const uint8 *a_record) {
+	return EEPROM_writeString(
+			BENCH_RING_ADDR + (a_index % BENCH_RING_SLOTS) * BENCH_RECORD_SIZE,
+			a_record, BENCH_RECORD_SIZE);
+}
+
+static const Bench_StrategyType g_strategies[] = {
+		{ "byte", bench_storeByte },
+		{ "page", bench_storePage },
+		{ "update", bench_storeUpdate },
+		{ "ring", bench_storeRing } };
+
+/*******************************************************************************
+ *                      Functions Definitions (Private)                        *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Runs one strategy on a fresh backing file and prints its row of the report.
+ */
+static uint8 bench_run(const Bench_StrategyType *a_strategy,
+		const char *a_dir) {
+	TWI_ConfigType config = { BENCH_BITRATE, 0x01, TWI_F_CPU_1 };
+	uint8 record[BENCH_RECORD_SIZE];
+	M24C16_SIM_StatsType stats;
+	char path[256];
+	uint32 payload = 0;
+	uint32 errors = 0;
+	uint32 wear_max = 0;
+	uint32 cells = 0;
+	uint32 wear;
+	double seconds;
+
+	snprintf(path, sizeof(path), "%s/bench_%s.bin", a_dir, a_strategy->Name);
+	remove(path);
+	if (M24C16_SIM_open(path) != SUCCESS) {
+		fprintf(stderr, "cannot create %s\n", path);
+		return ERROR;
+	}
+	TWI_init(&config);
+	M24C16_SIM_resetStats();
+
+	for (uint16 n = 0; n < BENCH_RECORDS; n++) {
+		for (uint8 i = 0; i < BENCH_RECORD_SIZE; i++) {
+			record[i] = (uint8) ((n / BENCH_CHANGE_EVERY) + i);
+		}
+		if (a_strategy->Store(n, record) == SUCCESS) {
+			payload += BENCH_RECORD_SIZE;
+		} else {
+			errors++;
+		}
+	}
+	/* The last write cycle belongs to the run */
+	while (!EEPROM_isReady()) {
+	}
+
+	M24C16_SIM_getStats(&stats);
+	for (uint16 addr = 0; addr < M24C16_SIM_SIZE; addr++) {
+		wear = M24C16_SIM_getCellWrites(addr);
+		if (wear != 0) {
+			cells++;
+		}
+		if (wear > wear_max) {
+			wear_max = wear;
+		}
+	}
+	seconds = M24C16_SIM_getTimeNs() / 1e9;
+	printf("%-8s %10.0f %8.2f %8.2f %8lu %8lu %8lu %8lu\n", a_strategy->Name,
+			(seconds > 0) ? payload / seconds : 0.0,
+			(payload != 0) ? (double) stats.cell_writes / payload : 0.0,
+			(payload != 0) ? (double) stats.bus_bytes / payload : 0.0,
+			(unsigned long) stats.write_cycles, (unsigned long) cells,
+			(unsigned long) wear_max, (unsigned long) errors);
+	M24C16_SIM_close();
+	return SUCCESS;
+}
+
+/*******************************************************************************
+ *                                  Main                                       *
+ *******************************************************************************/
+
+int main(int argc, char **argv) {
+	const char *dir = (argc > 1) ? argv[1] : ".";
+
+	printf("%u records of %u bytes, content changes every %u stores\n\n",
+			BENCH_RECORDS, BENCH_RECORD_SIZE, BENCH_CHANGE_EVERY);
+	printf("%-8s %10s %8s %8s %8s %8s %8s %8s\n", "strategy", "bytes/s",
+			"cell WA", "bus WA", "cycles", "cells", "max wear", "errors");
+	for (uint8 i = 0; i < sizeof(g_strategies) / sizeof(g_strategies[0]); i++) {
+		if (bench_run(&g_strategies[i], dir) != SUCCESS) {
+			return 1;
+		}
+	}
+	printf("\ncell WA: cells programmed per payload byte, "
+			"bus WA: bus bytes per payload byte\n");
+	return 0;
+}
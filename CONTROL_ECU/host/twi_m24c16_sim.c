@@ -0,0 +1,356 @@
+/******************************************************************************
+ *
+ * Module: TWI / I2C - Host M24C16 simulator
+ *
+ * File Name: twi_m24c16_sim.c
+ *
+ * Description: Host (Linux) implementation of the TWI driver API which
+ * 				emulates an M24C16 EEPROM backed by a memory mapped file.
+ *
+ * Date Created: 18/10/2026
+ *
+ * Author: Hazem Montasser
+ *
+ *******************************************************************************/
+
+/* Host only, compiles to nothing when the project is built for the target */
+#ifndef __AVR__
+
+#include "twi.h"
+#include "twi_m24c16_sim.h"
+#include "external_eeprom.h" /* For SUCCESS/ERROR */
+#include <stdint.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define M24C16_DEVICE_CODE 		(0xA0)	/* 1010xxxx: device type identifier */
+#define M24C16_DEVICE_MASK 		(0xF0)
+#define M24C16_BLOCK_MASK 		(0x0E)	/* A10,A9,A8 carried in the address byte */
+#define M24C16_RW_BIT 			(0x01)
+#define M24C16_PAGE_MASK 		(M24C16_SIM_PAGE_SIZE - 1)
+
+#define TWI_SIM_NO_STATUS 		(0xF8)	/* No relevant state information */
+#define TWI_SIM_BITS_PER_BYTE 	(9U)	/* 8 data bits + ACK */
+
+/* File layout: data array followed by one 32-bit write counter per cell */
+#define M24C16_FILE_SIZE (M24C16_SIM_SIZE + M24C16_SIM_SIZE * sizeof(uint32_t))
+
+/*******************************************************************************
+ *                               Types Declaration                             *
+ *******************************************************************************/
+
+/* Position of the master inside the current frame */
+typedef enum {
+	SIM_BUS_IDLE, /* After STOP */
+	SIM_BUS_SLA, /* After START, expecting slave address */
+	SIM_BUS_WORD_ADDR, /* Write frame, expecting the word address */
+	SIM_BUS_WRITE_DATA, /* Write frame, data bytes go to the page buffer */
+	SIM_BUS_READ_DATA, /* Read frame, device drives the data */
+	SIM_BUS_NOT_ADDRESSED /* Address was NACKed, device ignores the bus */
+} SIM_BusPhase;
+
+/*******************************************************************************
+ *                         Global Variables(Private)                           *
+ *******************************************************************************/
+
+static uint8 *g_memory = NULL_PTR; /* Mapped data array */
+static uint32_t *g_cell_writes = NULL_PTR; /* Mapped per-cell write counters */
+static int g_fd = -1;
+
+static uint32 g_bitrate = M24C16_SIM_DEFAULT_BITRATE;
+static uint32 g_write_cycle_us = M24C16_SIM_WRITE_CYCLE_US;
+static uint64 g_now_ns = 0;
+static uint64 g_busy_until_ns = 0;
+
+static SIM_BusPhase g_phase = SIM_BUS_IDLE;
+static uint8 g_status = TWI_SIM_NO_STATUS;
+static uint16 g_address = 0; /* Internal address counter */
+
+/* Page buffer: latched bytes and which of them were loaded */
+static uint8 g_page_data[M24C16_SIM_PAGE_SIZE];
+static uint16 g_page_loaded = 0;
+static uint16 g_page_base = 0;
+
+static M24C16_SIM_StatsType g_stats;
+static void (*g_TWI_callbackNotif)(void) = NULL_PTR;
+
+/*******************************************************************************
+ *                      Functions Definitions (Private)                        *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Advances the virtual clock by a number of SCL periods.
+ */
+static void sim_clock(uint32 a_bits) {
+	uint64 ns = ((uint64) a_bits * 1000000000ULL) / g_bitrate;
+	g_now_ns += ns;
+	g_stats.bus_time_ns += ns;
+}
+
+static boolean sim_deviceBusy(void) {
+	return (g_now_ns < g_busy_until_ns) ? TRUE : FALSE;
+}
+
+/*
+ * Description :
+ * Programs the latched bytes of the page buffer into the array and starts
+ * the internal write cycle. Only loaded bytes are programmed.
+ */
+static void sim_commitPage(void) {
+	if (g_page_loaded == 0) {
+		return;
+	}
+	for (uint8 i = 0; i < M24C16_SIM_PAGE_SIZE; i++) {
+		if (g_page_loaded & (1U << i)) {
+			uint16 addr = g_page_base | i;
+			if (g_memory != NULL_PTR) {
+				g_memory[addr] = g_page_data[i];
+				g_cell_writes[addr]++;
+			}
+			g_stats.cell_writes++;
+		}
+	}
+	g_stats.write_cycles++;
+	g_busy_until_ns = g_now_ns + (uint64) g_write_cycle_us * 1000ULL;
+	g_page_loaded = 0;
+}
+
+/*
+ * Description :
+ * A START (or repeated START) received while data bytes are latched aborts
+ * the page write, as on the real device.
+ */
+static void sim_abortPage(void) {
+	if (g_page_loaded != 0) {
+		g_stats.aborted_writes++;
+		g_page_loaded = 0;
+	}
+}
+
+/*******************************************************************************
+ *                      Functions Definitions (twi.h API)                      *
+ *******************************************************************************/
+
+void TWI_init(const TWI_ConfigType *Config) {
+	if (Config->BitRate != 0) {
+		g_bitrate = Config->BitRate;
+	}
+	g_phase = SIM_BUS_IDLE;
+	g_status = TWI_SIM_NO_STATUS;
+}
+
+Timeout_StatusType TWI_start(const Timeout_DeadlineType *a_deadline) {
+	sim_clock(1);
+	sim_abortPage();
+	g_status = (g_phase == SIM_BUS_IDLE) ? TWI_MT_START : TWI_MT_REP_START;
+	g_phase = SIM_BUS_SLA;
+	return TIMEOUT_STATUS_OK;
+}
+
+Timeout_StatusType TWI_stop(const Timeout_DeadlineType *a_deadline) {
+	sim_clock(1);
+	if (g_phase == SIM_BUS_WRITE_DATA) {
+		sim_commitPage();
+	}
+	g_page_loaded = 0;
+	g_phase = SIM_BUS_IDLE;
+	g_status = TWI_SIM_NO_STATUS;
+	return TIMEOUT_STATUS_OK;
+}
+
+Timeout_StatusType TWI_writeByte(uint8 a_data,
+		const Timeout_DeadlineType *a_deadline) {
+	sim_clock(TWI_SIM_BITS_PER_BYTE);
+	g_stats.bus_bytes++;
+
+	switch (g_phase) {
+	case SIM_BUS_SLA: {
+		boolean read = (a_data & M24C16_RW_BIT) ? TRUE : FALSE;
+		/* Device only answers its own type identifier and NACKs during tW */
+		if (((a_data & M24C16_DEVICE_MASK) != M24C16_DEVICE_CODE)
+				|| (g_memory == NULL_PTR)) {
+			g_status = read ? TWI_MT_SLA_R_NACK : TWI_MT_SLA_W_NACK;
+			g_phase = SIM_BUS_NOT_ADDRESSED;
+		} else if (sim_deviceBusy()) {
+			g_stats.busy_nacks++;
+			g_status = read ? TWI_MT_SLA_R_NACK : TWI_MT_SLA_W_NACK;
+			g_phase = SIM_BUS_NOT_ADDRESSED;
+		} else if (read) {
+			g_status = TWI_MT_SLA_R_ACK;
+			g_phase = SIM_BUS_READ_DATA;
+		} else {
+			/* Block bits select the upper 3 bits of the 11-bit address */
+			g_address = (uint16) (a_data & M24C16_BLOCK_MASK) << 7;
+			g_status = TWI_MT_SLA_W_ACK;
+			g_phase = SIM_BUS_WORD_ADDR;
+		}
+		break;
+	}
+	case SIM_BUS_WORD_ADDR:
+		g_address = (g_address & 0x0700) | a_data;
+		g_page_base = g_address & ~M24C16_PAGE_MASK;
+		g_page_loaded = 0;
+		g_status = TWI_MT_DATA_ACK;
+		g_phase = SIM_BUS_WRITE_DATA;
+		break;
+	case SIM_BUS_WRITE_DATA: {
+		/* Address counter rolls over inside the page (page write wrap) */
+		uint8 offset = g_address & M24C16_PAGE_MASK;
+		g_page_data[offset] = a_data;
+		g_page_loaded |= (1U << offset);
+		g_address = g_page_base | ((offset + 1) & M24C16_PAGE_MASK);
+		g_stats.data_bytes_written++;
+		g_status = TWI_MT_DATA_ACK;
+		break;
+	}
+	default:
+		/* Nobody is listening */
+		g_status = TWI_MT_DATA_NACK;
+		break;
+	}
+	return TIMEOUT_STATUS_OK;
+}
+
+Timeout_StatusType TWI_readByteWithAck(uint8 *a_data,
+		const Timeout_DeadlineType *a_deadline) {
+	uint8 data = 0xFF;
+	sim_clock(TWI_SIM_BITS_PER_BYTE);
+	g_stats.bus_bytes++;
+	if (g_phase == SIM_BUS_READ_DATA) {
+		data = g_memory[g_address];
+		/* Sequential read rolls over the whole array */
+		g_address = (g_address + 1) % M24C16_SIM_SIZE;
+		g_stats.data_bytes_read++;
+	}
+	g_status = TWI_MR_DATA_ACK;
+	*a_data = data;
+	return TIMEOUT_STATUS_OK;
+}
+
+Timeout_StatusType TWI_readByteWithNack(uint8 *a_data,
+		const Timeout_DeadlineType *a_deadline) {
+	TWI_readByteWithAck(a_data, a_deadline);
+	/* NACK ends the sequential read, device releases the bus */
+	g_status = TWI_MR_DATA_NACK;
+	return TIMEOUT_STATUS_OK;
+}
+
+uint8 TWI_getStatus(void) {
+	return g_status;
+}
+
+void TWI_setCallback(void (*a_PtrToFunc)(void)) {
+	/* No TWI interrupt on the host, kept for API compatibility */
+	g_TWI_callbackNotif = a_PtrToFunc;
+	(void) g_TWI_callbackNotif;
+}
+
+void TWI_DeInit(void) {
+	g_bitrate = M24C16_SIM_DEFAULT_BITRATE;
+	g_phase = SIM_BUS_IDLE;
+	g_status = TWI_SIM_NO_STATUS;
+	g_page_loaded = 0;
+}
+
+/*******************************************************************************
+ *                      Functions Definitions (Simulator)                      *
+ *******************************************************************************/
+
+uint8 M24C16_SIM_open(const char *a_path) {
+	struct stat st;
+	boolean fresh;
+	void *map;
+
+	M24C16_SIM_close();
+	g_fd = open(a_path, O_RDWR | O_CREAT, 0644);
+	if (g_fd < 0) {
+		return ERROR;
+	}
+	if (fstat(g_fd, &st) != 0) {
+		close(g_fd);
+		g_fd = -1;
+		return ERROR;
+	}
+	fresh = (st.st_size < (off_t) M24C16_FILE_SIZE) ? TRUE : FALSE;
+	if (fresh && ftruncate(g_fd, M24C16_FILE_SIZE) != 0) {
+		close(g_fd);
+		g_fd = -1;
+		return ERROR;
+	}
+	map = mmap(NULL, M24C16_FILE_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, g_fd,
+			0);
+	if (map == MAP_FAILED) {
+		close(g_fd);
+		g_fd = -1;
+		return ERROR;
+	}
+	g_memory = (uint8*) map;
+	g_cell_writes = (uint32_t*) (g_memory + M24C16_SIM_SIZE);
+	if (fresh) {
+		/* Erased EEPROM reads 0xFF */
+		memset(g_memory, 0xFF, M24C16_SIM_SIZE);
+		memset(g_cell_writes, 0, M24C16_SIM_SIZE * sizeof(uint32_t));
+	}
+	g_now_ns = 0;
+	g_busy_until_ns = 0;
+	g_address = 0;
+	g_phase = SIM_BUS_IDLE;
+	g_page_loaded = 0;
+	M24C16_SIM_resetStats();
+	return SUCCESS;
+}
+
+void M24C16_SIM_close(void) {
+	if (g_memory != NULL_PTR) {
+		msync(g_memory, M24C16_FILE_SIZE, MS_SYNC);
+		munmap(g_memory, M24C16_FILE_SIZE);
+		g_memory = NULL_PTR;
+		g_cell_writes = NULL_PTR;
+	}
+	if (g_fd >= 0) {
+		close(g_fd);
+		g_fd = -1;
+	}
+}
+
+void M24C16_SIM_setWriteCycleTime(uint32 a_us) {
+	g_write_cycle_us = a_us;
+}
+
+void M24C16_SIM_advanceTime(uint32 a_us) {
+	g_now_ns += (uint64) a_us * 1000ULL;
+	g_stats.idle_time_ns += (uint64) a_us * 1000ULL;
+}
+
+uint64 M24C16_SIM_getTimeNs(void) {
+	return g_now_ns;
+}
+
+boolean M24C16_SIM_isBusy(void) {
+	return sim_deviceBusy();
+}
+
+void M24C16_SIM_getStats(M24C16_SIM_StatsType *a_stats) {
+	*a_stats = g_stats;
+}
+
+void M24C16_SIM_resetStats(void) {
+	memset(&g_stats, 0, sizeof(g_stats));
+}
+
+uint32 M24C16_SIM_getCellWrites(uint16 a_addr) {
+	if ((g_cell_writes == NULL_PTR) || (a_addr >= M24C16_SIM_SIZE)) {
+		return 0;
+	}
+	return g_cell_writes[a_addr];
+}
+
+#endif /* __AVR__ */
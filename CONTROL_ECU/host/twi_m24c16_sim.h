@@ -0,0 +1,199 @@
+/******************************************************************************
+ *
+ * Module: TWI / I2C - Host M24C16 simulator
+ *
+ * File Name: twi_m24c16_sim.h
+ *
+ * Description: Header file for the host (Linux) implementation of the TWI
+ * 				driver API which emulates an M24C16 EEPROM at slave address 0xA0.
+ *
+ * 				twi_m24c16_sim.c provides every function of twi.h, so the target
+ * 				external_eeprom.c can be linked against it unchanged, e.g:
+ *
+ * 				gcc -I. -Ihost external_eeprom.c timeout.c host/twi_m24c16_sim.c
+ * 					host/bench.c
+ *
+ * 				The host program provides SysTick_getMillis for the driver
+ * 				deadlines, host/bench.c derives it from M24C16_SIM_getTimeNs() so
+ * 				they run on the virtual clock.
+ * 				Deadline arguments are accepted but the simulated bus never hangs.
+ *
+ * 				The EEPROM array and the per-cell write counters live in a file
+ * 				which is memory mapped, so contents and wear survive between runs.
+ *
+ * 				The simulator keeps a virtual clock which advances by the SCL time
+ * 				of every start, stop and byte on the bus (at the bit-rate passed to
+ * 				TWI_init) and by M24C16_SIM_advanceTime(). While the internal write
+ * 				cycle (tW, 5ms by default) is running the device NACKs its address.
+ *
+ * Date Created: 18/10/2026
+ *
+ * Author: Hazem Montasser
+ *
+ *******************************************************************************/
+
+#ifndef TWI_M24C16_SIM_H_
+#define TWI_M24C16_SIM_H_
+
+#include "std_types.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define M24C16_SIM_SIZE 			(2048U)	/* M24C16 = 16Kbit = 2KB */
+#define M24C16_SIM_PAGE_SIZE 		(16U)	/* Page write buffer size */
+#define M24C16_SIM_WRITE_CYCLE_US 	(5000UL)/* Default internal write cycle time (tW)*/
+#define M24C16_SIM_DEFAULT_BITRATE 	(100000UL)/* SCL used when TWI_init was not called */
+
+/*******************************************************************************
+ *                               Types Declaration                             *
+ *******************************************************************************/
+
+/******************************************************************************
+ *
+ * Structure Name: M24C16_SIM_StatsType
+ *
+ * Structure Description: Bus and memory array counters accumulated since
+ * 		M24C16_SIM_open() or the last M24C16_SIM_resetStats().
+ *
+ *******************************************************************************/
+typedef struct {
+	uint64 bus_time_ns; /* SCL time spent on starts, stops & bytes */
+	uint64 idle_time_ns; /* Time added through M24C16_SIM_advanceTime() */
+	uint32 bus_bytes; /* Bytes clocked on the bus in both directions (incl. addresses) */
+	uint32 data_bytes_read; /* Data bytes returned to the master */
+	uint32 data_bytes_written; /* Data bytes latched into the page buffer */
+	uint32 cell_writes; /* Cells programmed by completed write cycles */
+	uint32 write_cycles; /* Completed internal write cycles (one per page write) */
+	uint32 aborted_writes; /* Page writes discarded because no STOP was sent */
+	uint32 busy_nacks; /* Address NACKs returned during the write cycle */
+} M24C16_SIM_StatsType;
+
+/*******************************************************************************
+ *                              Functions Prototypes                           *
+ *******************************************************************************/
+
+/******************************************************************************
+ *
+ * Function Name: M24C16_SIM_open
+ *
+ * Description: Maps the backing file of the simulated EEPROM, creating it
+ * 		(erased to 0xFF, all write counters 0) if it does not exist.
+ *
+ * Args:
+ *
+ * 		[in] const char *a_path
+ * 			Path of the backing file.
+ * 		[out] N/A
+ * Returns: uint8 (SUCCESS/ERROR)
+ *
+ *******************************************************************************/
+uint8 M24C16_SIM_open(const char *a_path);
+
+/******************************************************************************
+ *
+ * Function Name: M24C16_SIM_close
+ *
+ * Description: Flushes and unmaps the backing file.
+ * Args: void
+ * Returns: void
+ *******************************************************************************/
+void M24C16_SIM_close(void);
+
+/******************************************************************************
+ *
+ * Function Name: M24C16_SIM_setWriteCycleTime
+ *
+ * Description: Changes the internal write cycle time, 0 disables busy NACKs.
+ *
+ * Args:
+ *
+ * 		[in] uint32 a_us
+ * 			Write cycle time in microseconds.
+ * 		[out] N/A
+ * Returns: void
+ *
+ *******************************************************************************/
+void M24C16_SIM_setWriteCycleTime(uint32 a_us);
+
+/******************************************************************************
+ *
+ * Function Name: M24C16_SIM_advanceTime
+ *
+ * Description: Advances the virtual clock, used by the host to model time
+ * 		spent outside the bus (delays, polling loops, application work).
+ *
+ * Args:
+ *
+ * 		[in] uint32 a_us
+ * 			Time to add in microseconds.
+ * 		[out] N/A
+ * Returns: void
+ *
+ *******************************************************************************/
+void M24C16_SIM_advanceTime(uint32 a_us);
+
+/******************************************************************************
+ *
+ * Function Name: M24C16_SIM_getTimeNs
+ *
+ * Description: Returns the current virtual time in nanoseconds.
+ * Args: void
+ * Returns: uint64
+ *******************************************************************************/
+uint64 M24C16_SIM_getTimeNs(void);
+
+/******************************************************************************
+ *
+ * Function Name: M24C16_SIM_isBusy
+ *
+ * Description: Returns TRUE while the internal write cycle is in progress.
+ * Args: void
+ * Returns: boolean
+ *******************************************************************************/
+boolean M24C16_SIM_isBusy(void);
+
+/******************************************************************************
+ *
+ * Function Name: M24C16_SIM_getStats
+ *
+ * Description: Copies the accumulated counters into a_stats.
+ *
+ * Args:
+ *
+ * 		[in] N/A
+ * 		[out] M24C16_SIM_StatsType *a_stats
+ * Returns: void
+ *
+ *******************************************************************************/
+void M24C16_SIM_getStats(M24C16_SIM_StatsType *a_stats);
+
+/******************************************************************************
+ *
+ * Function Name: M24C16_SIM_resetStats
+ *
+ * Description: Clears the bus counters, the per-cell write counters are kept.
+ * Args: void
+ * Returns: void
+ *******************************************************************************/
+void M24C16_SIM_resetStats(void);
+
+/******************************************************************************
+ *
+ * Function Name: M24C16_SIM_getCellWrites
+ *
+ * Description: Returns how many times a cell was programmed over the whole
+ * 		life of the backing file, used to plot the wear distribution.
+ *
+ * Args:
+ *
+ * 		[in] uint16 a_addr
+ * 			Memory address (0 - 2047)
+ * 		[out] N/A
+ * Returns: uint32
+ *
+ *******************************************************************************/
+uint32 M24C16_SIM_getCellWrites(uint16 a_addr);
+
+#endif /* TWI_M24C16_SIM_H_ */
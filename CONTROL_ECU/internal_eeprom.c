@@ -0,0 +1,58 @@
+/******************************************************************************
+ *
+ * Module: Internal EEPROM (ATmega16)
+ *
+ * File Name: internal_eeprom.c
+ *
+ * Description: Source file for the on-chip EEPROM driver.
+ *
+ * Date Created: 18/10/2026
+ *
+ * Author: Hazem Montasser
+ *
+ *******************************************************************************/
+
+#include "internal_eeprom.h"
+#include <avr/eeprom.h>
+
+/*******************************************************************************
+ *                          Functions Definitions                              *
+ *******************************************************************************/
+
+uint8 IEEPROM_writeByte(uint16 a_addr, uint8 a_data) {
+	if (a_addr >= IEEPROM_SIZE) {
+		return ERROR;
+	}
+	/* avr-libc keeps the EEMWE -> EEWE sequence within 4 cycles with
+	 * interrupts disabled, which plain C at -O0 cannot guarantee */
+	eeprom_update_byte((uint8*) a_addr, a_data);
+	return SUCCESS;
+}
+
+uint8 IEEPROM_readByte(uint16 a_addr, uint8 *a_data) {
+	if (a_addr >= IEEPROM_SIZE) {
+		return ERROR;
+	}
+	*a_data = eeprom_read_byte((const uint8*) a_addr);
+	return SUCCESS;
+}
+
+uint8 IEEPROM_writeString(uint16 a_addr, const uint8 *str, uint8 size) {
+	if ((uint32) a_addr + size > IEEPROM_SIZE) {
+		return ERROR;
+	}
+	eeprom_update_block(str, (void*) a_addr, size);
+	return SUCCESS;
+}
+
+uint8 IEEPROM_readString(uint16 a_addr, uint8 *str, uint8 size) {
+	if ((uint32) a_addr + size > IEEPROM_SIZE) {
+		return ERROR;
+	}
+	eeprom_read_block(str, (const void*) a_addr, size);
+	return SUCCESS;
+}
+
+boolean IEEPROM_isReady(void) {
+	return eeprom_is_ready() ? TRUE : FALSE;
+}
@@ -0,0 +1,123 @@
+/******************************************************************************
+ *
+ * Module: Internal EEPROM (ATmega16)
+ *
+ * File Name: internal_eeprom.h
+ *
+ * Description: Header file for the on-chip EEPROM driver.
+ * 				Same interface as the external EEPROM driver so the storage
+ * 				layer can use both tiers the same way.
+ *
+ * Date Created: 18/10/2026
+ *
+ * Author: Hazem Montasser
+ *
+ *******************************************************************************/
+
+#ifndef INTERNAL_EEPROM_H_
+#define INTERNAL_EEPROM_H_
+
+#include "std_types.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define ERROR 				 (0x00)
+#define SUCCESS 			 (0x01)
+#define IEEPROM_SIZE 		 (512U)	/* ATmega16 on-chip EEPROM size in bytes */
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+
+/******************************************************************************
+ *
+ * Function Name: IEEPROM_writeByte
+ *
+ * Description:  Writes a byte to a specific address in the on-chip EEPROM.
+ * 		The cell is only programmed if its content differs (saves ~8.5ms and
+ * 		one erase/write cycle of the cell's endurance).
+ *
+ * Args:
+ *
+ * 		[in] uint16 a_addr
+ * 				9-bit address (0 - 511)
+ * 			 uint8 a_data
+ * 			 	Actual byte to store in the EEPROM address location
+ * 		[out] N/A
+ * Returns: uint8 (SUCCESS/ERROR)
+ *
+ *******************************************************************************/
+uint8 IEEPROM_writeByte(uint16 a_addr, uint8 a_data);
+
+/******************************************************************************
+ *
+ * Function Name: IEEPROM_readByte
+ *
+ * Description:  Reads a byte from a specific address in the on-chip EEPROM.
+ *
+ * Args:
+ *
+ * 		[in] uint16 a_addr
+ * 				9-bit address (0 - 511)
+ * 			 uint8 *a_data
+ *				Pointer to variable in which the byte is received from EEPROM
+ * 		[out] N/A
+ * Returns: uint8 (SUCCESS/ERROR)
+ *
+ *******************************************************************************/
+uint8 IEEPROM_readByte(uint16 a_addr, uint8 *a_data);
+
+/******************************************************************************
+ *
+ * Function Name: IEEPROM_writeString
+ *
+ * Description:  Writes an array of bytes to a specific address in the on-chip
+ * 		EEPROM, unchanged bytes are skipped.
+ * Args:
+ *
+ * 		[in] uint16 a_addr
+ * 				9-bit address (0 - 511)
+ * 			 const uint8 *str
+ * 			 	Actual array to store in the EEPROM address location
+ * 			 uint8 size
+ * 			 	Number of bytes to write
+ * 		[out] N/A
+ * Returns: uint8 (SUCCESS/ERROR)
+ *
+ *******************************************************************************/
+uint8 IEEPROM_writeString(uint16 a_addr, const uint8 *str, uint8 size);
+
+/******************************************************************************
+ *
+ * Function Name: IEEPROM_readString
+ *
+ * Description:  Reads an array of bytes starting from a specific address in
+ * 		the on-chip EEPROM.
+ * Args:
+ *
+ * 		[in] uint16 a_addr
+ * 				9-bit address (0 - 511)
+ * 			 uint8 *str
+ * 			 	Actual array to store data in
+ * 			 uint8 size
+ * 			 	Number of bytes to read
+ * 		[out] N/A
+ * Returns: uint8 (SUCCESS/ERROR)
+ *
+ *******************************************************************************/
+uint8 IEEPROM_readString(uint16 a_addr, uint8 *str, uint8 size);
+
+/******************************************************************************
+ *
+ * Function Name: IEEPROM_isReady
+ *
+ * Description:  Returns TRUE if no write is in progress, so the next access
+ * 		will not have to wait.
+ * Args: void
+ * Returns: boolean
+ *******************************************************************************/
+boolean IEEPROM_isReady(void);
+
+#endif /* INTERNAL_EEPROM_H_ */
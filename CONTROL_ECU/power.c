@@ -0,0 +1,100 @@
+/******************************************************************************
+ *
+ * Module: Power
+ *
+ * File Name: power.c
+ *
+ * Description: Source file for the reset classification and supply monitor.
+ *
+ * Date Created: 18/10/2026
+ *
+ * Author: Hazem Montasser
+ *
+ *******************************************************************************/
+
+#include "power.h"
+#include "common_macros.h"
+#include "profiler.h"
+#include <avr/io.h>
+#include <avr/interrupt.h>
+
+/*******************************************************************************
+ *                         Global Variables(Private)                           *
+ *******************************************************************************/
+
+static void (*volatile g_Power_callbackNotif)(void) = NULL_PTR;
+static uint8 g_reset_flags = 0; /* MCUCSR reset flags of this boot */
+
+/*******************************************************************************
+ *                              ISR's Definitions                              *
+ *******************************************************************************/
+#if (POWER_MONITOR_ENABLE == TRUE)
+ISR(ANA_COMP_vect) {
+	PROFILE_BEGIN(PROBE_ISR_ANA_COMP);
+	if (g_Power_callbackNotif != NULL_PTR) {
+		(*g_Power_callbackNotif)();
+	}
+	PROFILE_END(PROBE_ISR_ANA_COMP);
+}
+#endif
+
+/*******************************************************************************
+ *                              Functions Definitions                          *
+ *******************************************************************************/
+
+void Power_init(void) {
+	/* Flags are sticky across resets, clear them so the next boot only
+	 * sees its own cause */
+	g_reset_flags = MCUCSR & ((1 << JTRF) | (1 << WDRF) | (1 << BORF)
+			| (1 << EXTRF) | (1 << PORF));
+	MCUCSR &= ~((1 << JTRF) | (1 << WDRF) | (1 << BORF) | (1 << EXTRF)
+			| (1 << PORF));
+
+#if (POWER_MONITOR_ENABLE == TRUE)
+	/* AIN1 (PB3) input without pull-up */
+	CLEAR_BIT(DDRB, PB3);
+	CLEAR_BIT(PORTB, PB3);
+	/* ACME = 0 -> AIN1 is the negative input (ADC mux not used) */
+	CLEAR_BIT(SFIOR, ACME);
+	/*
+	 * ACBG = 1        -> Bandgap reference on the positive input
+	 * ACIS1:0 = 00    -> Interrupt on output toggle (both directions)
+	 * ACI  = 1        -> Clear a pending flag before enabling the interrupt
+	 * ACIE = 1        -> Enable interrupt
+	 * */
+	ACSR = (1 << ACBG) | (1 << ACI);
+	ACSR |= (1 << ACIE);
+#endif
+}
+
+uint8 Power_getResetFlags(void) {
+	return g_reset_flags;
+}
+
+Power_ResetCauseType Power_getResetCause(void) {
+	if (g_reset_flags & (1 << PORF)) {
+		return POWER_RESET_POWER_ON;
+	} else if (g_reset_flags & (1 << BORF)) {
+		return POWER_RESET_BROWN_OUT;
+	} else if (g_reset_flags & (1 << WDRF)) {
+		return POWER_RESET_WATCHDOG;
+	} else if (g_reset_flags & (1 << EXTRF)) {
+		return POWER_RESET_EXTERNAL;
+	} else if (g_reset_flags & (1 << JTRF)) {
+		return POWER_RESET_JTAG;
+	}
+	return POWER_RESET_UNKNOWN;
+}
+
+boolean Power_isSupplyMarginal(void) {
+#if (POWER_MONITOR_ENABLE == TRUE)
+	/* ACO = 1 -> bandgap above the divided supply */
+	return BIT_IS_SET(ACSR, ACO) ? TRUE : FALSE;
+#else
+	return FALSE;
+#endif
+}
+
+void Power_setCallback(void (*a_ptrToCallback)(void)) {
+	g_Power_callbackNotif = a_ptrToCallback;
+}
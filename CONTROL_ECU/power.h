@@ -0,0 +1,124 @@
+/******************************************************************************
+ *
+ * Module: Power
+ *
+ * File Name: power.h
+ *
+ * Description: Header file for the reset classification and supply monitor.
+ *
+ * 				Brown-out detection on the ATmega16 can only be enabled by fuses,
+ * 				firmware cannot turn it on. For a 5V supply program:
+ * 					BODEN = 0 (enabled), BODLEVEL = 0 (4.0V)
+ * 				i.e. clear bits 7-6 of the board's current low fuse and keep the
+ * 				clock bits (CKSEL, SUT). For the internal 8MHz RC oscillator
+ * 				(CKSEL = 0100, SUT = 10): avrdude -U lfuse:w:0x24:m
+ * 				A crystal board needs its own CKSEL/SUT bits, a wrong clock
+ * 				source stops the MCU.
+ *
+ * 				The BOD only resets the MCU once the supply is already too low, so
+ * 				an early warning is taken from the analog comparator: the internal
+ * 				bandgap (1.23V) on the positive input and a divided supply on AIN1
+ * 				(PB3). With the divider below the comparator output goes high at
+ * 				1.23V * (3.3K + 1.3K) / 1.3K = ~4.35V (4.07V - 4.78V over the
+ * 				1.15V - 1.35V bandgap tolerance), leaving the hold-up capacitor
+ * 				time to flush pending writes before the BOD trips:
+ *
+ * 					VCC --[ 3.3K ]--+-- AIN1 (PB3)
+ * 					                |
+ * 					               [1.3K]
+ * 					                |
+ * 					               GND
+ *
+ * Date Created: 18/10/2026
+ *
+ * Author: Hazem Montasser
+ *
+ *******************************************************************************/
+
+#ifndef POWER_H_
+#define POWER_H_
+
+#include "std_types.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define POWER_MONITOR_ENABLE TRUE	/* Supply monitor on the analog comparator */
+
+/*******************************************************************************
+ *                               Types Declaration                             *
+ *******************************************************************************/
+
+/* Cause of the last reset, from the MCUCSR flags */
+typedef enum {
+	POWER_RESET_POWER_ON,
+	POWER_RESET_EXTERNAL,
+	POWER_RESET_BROWN_OUT,
+	POWER_RESET_WATCHDOG,
+	POWER_RESET_JTAG,
+	POWER_RESET_UNKNOWN
+} Power_ResetCauseType;
+
+/*******************************************************************************
+ *                              Functions Prototypes                           *
+ *******************************************************************************/
+
+/******************************************************************************
+ *
+ * Function Name: Power_init
+ *
+ * Description: Latches and clears the MCUCSR reset flags, then starts the
+ * 		supply monitor if POWER_MONITOR_ENABLE is TRUE.
+ * 		---Note: Must be the first module initialized after reset.
+ * Args: void
+ * Returns: void
+ *******************************************************************************/
+void Power_init(void);
+
+/******************************************************************************
+ *
+ * Function Name: Power_getResetFlags
+ *
+ * Description: Returns the raw MCUCSR reset flags latched by Power_init.
+ * Args: void
+ * Returns: uint8
+ *******************************************************************************/
+uint8 Power_getResetFlags(void);
+
+/******************************************************************************
+ *
+ * Function Name: Power_getResetCause
+ *
+ * Description: Classifies the latched reset flags. Power-on takes precedence
+ * 		since the other flags are undefined after a power-on reset.
+ * Args: void
+ * Returns: Power_ResetCauseType
+ *******************************************************************************/
+Power_ResetCauseType Power_getResetCause(void);
+
+/******************************************************************************
+ *
+ * Function Name: Power_isSupplyMarginal
+ *
+ * Description: Returns TRUE while the divided supply is below the bandgap.
+ * Args: void
+ * Returns: boolean
+ *******************************************************************************/
+boolean Power_isSupplyMarginal(void);
+
+/******************************************************************************
+ *
+ * Function Name: Power_setCallback
+ *
+ * Description: Sets the function called (in interrupt context) whenever the
+ * 		supply crosses the threshold in either direction.
+ * Args:
+ * 		[in] void (*a_ptrToCallback)(void)
+ * 			Pointer to the callback function.
+ * 		[out] N/A
+ * Returns: void
+ *******************************************************************************/
+void Power_setCallback(void (*a_ptrToCallback)(void));
+
+#endif /* POWER_H_ */
@@ -0,0 +1,155 @@
+/******************************************************************************
+ *
+ * Module: Profiler
+ *
+ * File Name: profiler.c
+ *
+ * Description: Source file for the cycle-level hot-path profiler.
+ *
+ * Date Created: 18/10/2026
+ *
+ * Author: Hazem Montasser
+ *
+ *******************************************************************************/
+
+#include "profiler.h"
+
+#if (PROFILER_ENABLE == TRUE)
+
+#include "timer.h"
+#include <util/atomic.h>
+
+/*******************************************************************************
+ *                         Global Variables                                    *
+ *******************************************************************************/
+
+volatile uint16 g_Profiler_overflows = 0;
+
+/*******************************************************************************
+ *                         Global Variables(Private)                           *
+ *******************************************************************************/
+
+static Profiler_EntryType g_table[PROBE_COUNT];
+static uint32 g_overhead = 0; /* Cycles of an empty BEGIN/END pair */
+
+/*******************************************************************************
+ *                      Functions Definitions (Private)                        *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Timer1 overflow callback, extends the timestamp to 32 bits.
+ */
+static void profiler_overflow(void) {
+	g_Profiler_overflows++;
+}
+
+/*
+ * Description :
+ * Sends a uint32 little-endian.
+ */
+static void profiler_send32(void (*a_ptrToSend)(uint8), uint32 a_value) {
+	for (uint8 i = 0; i < 4; i++) {
+		a_ptrToSend((uint8) a_value);
+		a_value >>= 8;
+	}
+}
+
+#endif
+
+/*******************************************************************************
+ *                              Functions Definitions                          *
+ *******************************************************************************/
+
+void Profiler_init(void) {
+#if (PROFILER_ENABLE == TRUE)
+	/*
+	 * Timer init:
+	 * 	Timer used = Timer1
+	 * 	Pre-scaler clock = F_CPU/1
+	 * 	Mode = Normal (free-running, overflow every 65536 cycles)
+	 * 	Interrupt on overflow = TRUE for enabled
+	 * */
+	Timer_ConfigType TIMER_CONFIG = { TIMER1_ID, FCPU_1_T01, Timer_Mode_Normal,
+			0, TRUE };
+	uint32 cycles = 0;
+
+	for (uint8 i = 0; i < PROBE_COUNT; i++) {
+		g_table[i].Count = 0;
+		g_table[i].Min = 0xFFFFFFFF;
+		g_table[i].Max = 0;
+		g_table[i].Total = 0;
+	}
+	g_Profiler_overflows = 0;
+	Timer_setSourceCallback(TIMER1_OVF_SOURCE, profiler_overflow);
+	Timer_init(&TIMER_CONFIG);
+
+	/* Overhead = smallest empty pair out of a few */
+	g_overhead = 0xFFFFFFFF;
+	for (uint8 i = 0; i < 4; i++) {
+		uint32 start = Profiler_now();
+		cycles = Profiler_now() - start;
+		if (cycles < g_overhead) {
+			g_overhead = cycles;
+		}
+	}
+#endif
+}
+
+void Profiler_record(Profiler_ProbeType a_probe, uint32 a_cycles) {
+#if (PROFILER_ENABLE == TRUE)
+	Profiler_EntryType *entry;
+	if (a_probe >= PROBE_COUNT) {
+		return;
+	}
+	entry = &g_table[a_probe];
+	a_cycles = (a_cycles > g_overhead) ? (a_cycles - g_overhead) : 0;
+	entry->Count++;
+	if (a_cycles < entry->Min) {
+		entry->Min = a_cycles;
+	}
+	if (a_cycles > entry->Max) {
+		entry->Max = a_cycles;
+	}
+	entry->Total =
+			(entry->Total > 0xFFFFFFFF - a_cycles) ?
+					0xFFFFFFFF : entry->Total + a_cycles;
+#endif
+}
+
+void Profiler_getEntry(Profiler_ProbeType a_probe, Profiler_EntryType *a_entry) {
+#if (PROFILER_ENABLE == TRUE)
+	if (a_probe < PROBE_COUNT) {
+		/* ISR probes may update the entry meanwhile */
+		ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+		{
+			*a_entry = g_table[a_probe];
+		}
+	}
+#else
+	a_entry->Count = 0;
+	a_entry->Min = 0;
+	a_entry->Max = 0;
+	a_entry->Total = 0;
+#endif
+}
+
+void Profiler_dump(void (*a_ptrToSend)(uint8)) {
+#if (PROFILER_ENABLE == TRUE)
+	Profiler_EntryType entry;
+	a_ptrToSend(PROFILER_DUMP_SIZE);
+	a_ptrToSend(PROBE_COUNT);
+	for (uint8 i = 0; i < PROBE_COUNT; i++) {
+		Profiler_getEntry(i, &entry);
+		a_ptrToSend(i);
+		profiler_send32(a_ptrToSend, entry.Count);
+		profiler_send32(a_ptrToSend, (entry.Count != 0) ? entry.Min : 0);
+		profiler_send32(a_ptrToSend, entry.Max);
+		profiler_send32(a_ptrToSend,
+				(entry.Count != 0) ? entry.Total / entry.Count : 0);
+	}
+#else
+	a_ptrToSend(PROFILER_DUMP_SIZE);
+	a_ptrToSend(0);
+#endif
+}
@@ -0,0 +1,187 @@
+/******************************************************************************
+ *
+ * Module: Profiler
+ *
+ * File Name: profiler.h
+ *
+ * Description: Header file for the cycle-level hot-path profiler.
+ *
+ * 				Timer1 runs free at F_CPU/1 (one count per CPU cycle) and counts
+ * 				its overflows, giving a 32-bit cycle timestamp. A probe is a
+ * 				PROFILE_BEGIN/PROFILE_END pair around the code to measure:
+ *
+ * 					PROFILE_BEGIN(PROBE_PASS_COMPARE);
+ * 					...
+ * 					PROFILE_END(PROBE_PASS_COMPARE);
+ *
+ * 				Each probe accumulates count, min, max and total cycles (minus
+ * 				the probe's own overhead, measured by Profiler_init). Times of a
+ * 				probe include any interrupt serviced between its BEGIN and END.
+ *
+ * 				With PROFILER_ENABLE = FALSE the macros expand to nothing and
+ * 				Timer1 is left untouched.
+ *
+ * Date Created: 18/10/2026
+ *
+ * Author: Hazem Montasser
+ *
+ *******************************************************************************/
+
+#ifndef PROFILER_H_
+#define PROFILER_H_
+
+#include "std_types.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define PROFILER_ENABLE 		FALSE	/* TRUE to compile the probes in (uses Timer1) */
+
+/*******************************************************************************
+ *                               Types Declaration                             *
+ *******************************************************************************/
+
+/* Probe ID's, shared by both ECU's so dumps decode the same way */
+typedef enum {
+	PROBE_UART_RECEIVE_STRING,
+	PROBE_PASS_COMPARE,
+	PROBE_EEPROM_WRITE_STRING,
+	PROBE_LCD_DISPLAY_STRING,
+	PROBE_ISR_UART_RXC,
+	PROBE_ISR_TIMER2_COMP,
+	PROBE_ISR_TWI,
+	PROBE_ISR_ANA_COMP,
+	PROBE_COUNT
+} Profiler_ProbeType;
+
+/* Length of the table sent by Profiler_dump, after its length byte */
+#if (PROFILER_ENABLE == TRUE)
+#define PROFILER_DUMP_SIZE 	(1U + PROBE_COUNT * 17U)
+#else
+#define PROFILER_DUMP_SIZE 	(1U)
+#endif
+
+/******************************************************************************
+ *
+ * Structure Name: Profiler_EntryType
+ *
+ * Structure Description: Statistics of one probe, in CPU cycles.
+ *
+ *******************************************************************************/
+typedef struct {
+	uint32 Count; /* Completed BEGIN/END pairs */
+	uint32 Min;
+	uint32 Max;
+	uint32 Total; /* Saturates at 0xFFFFFFFF, mean = Total / Count */
+} Profiler_EntryType;
+
+#if (PROFILER_ENABLE == TRUE)
+
+#include <avr/io.h>
+
+/* Timer1 overflows, upper half of the cycle timestamp (updated by the ISR) */
+extern volatile uint16 g_Profiler_overflows;
+
+/*******************************************************************************
+ *                                   Macros                                    *
+ *******************************************************************************/
+
+#define PROFILE_BEGIN(probe)	uint32 profiler_start_##probe = Profiler_now()
+#define PROFILE_END(probe)		Profiler_record((probe), Profiler_now() - profiler_start_##probe)
+
+/*
+ * Description :
+ * Returns the 32-bit cycle timestamp. If Timer1 overflowed but its ISR has
+ * not run yet (called with interrupts disabled), the pending overflow is
+ * counted.
+ */
+static inline uint32 Profiler_now(void) {
+	uint8 sreg = SREG;
+	uint16 low;
+	uint16 high;
+	__asm__ __volatile__ ("cli" ::: "memory");
+	low = TCNT1;
+	high = g_Profiler_overflows;
+	if ((TIFR & (1 << TOV1)) && low < 0x8000) {
+		high++;
+	}
+	SREG = sreg;
+	return ((uint32) high << 16) | low;
+}
+
+#else
+
+#define PROFILE_BEGIN(probe)
+#define PROFILE_END(probe)
+
+#endif
+
+/*******************************************************************************
+ *                              Functions Prototypes                           *
+ *******************************************************************************/
+
+/******************************************************************************
+ *
+ * Function Name: Profiler_init
+ *
+ * Description: Starts Timer1 free-running at F_CPU/1, clears the table and
+ * 		measures the overhead of an empty probe. Does nothing if
+ * 		PROFILER_ENABLE is FALSE.
+ * Args: void
+ * Returns: void
+ *******************************************************************************/
+void Profiler_init(void);
+
+/******************************************************************************
+ *
+ * Function Name: Profiler_record
+ *
+ * Description: Adds one measurement to a probe, used by PROFILE_END.
+ *
+ * Args:
+ *
+ * 		[in] Profiler_ProbeType a_probe
+ * 			 uint32 a_cycles
+ * 			Cycles between BEGIN and END, the probe overhead is subtracted.
+ * 		[out] N/A
+ * Returns: void
+ *
+ *******************************************************************************/
+void Profiler_record(Profiler_ProbeType a_probe, uint32 a_cycles);
+
+/******************************************************************************
+ *
+ * Function Name: Profiler_getEntry
+ *
+ * Description: Copies the statistics of a probe into a_entry.
+ *
+ * Args:
+ *
+ * 		[in] Profiler_ProbeType a_probe
+ * 		[out] Profiler_EntryType *a_entry
+ * Returns: void
+ *
+ *******************************************************************************/
+void Profiler_getEntry(Profiler_ProbeType a_probe, Profiler_EntryType *a_entry);
+
+/******************************************************************************
+ *
+ * Function Name: Profiler_dump
+ *
+ * Description: Sends the table byte by byte, prefixed by its length in bytes
+ * 		(PROFILER_DUMP_SIZE) so a receiver can skip it: the number of probes,
+ * 		then per probe its ID, Count, Min, Max and Mean as little-endian
+ * 		uint32's. The number of probes is 0 if PROFILER_ENABLE is FALSE.
+ *
+ * Args:
+ *
+ * 		[in] void (*a_ptrToSend)(uint8)
+ * 			Byte output, e.g. UART_sendByte.
+ * 		[out] N/A
+ * Returns: void
+ *
+ *******************************************************************************/
+void Profiler_dump(void (*a_ptrToSend)(uint8));
+
+#endif /* PROFILER_H_ */
@@ -0,0 +1,115 @@
+/******************************************************************************
+ *
+ * Module: Real Time Clock
+ *
+ * File Name: rtc.c
+ *
+ * Description: Source file for the software real time clock.
+ *
+ * Date Created: 18/10/2026
+ *
+ * Author: Hazem Montasser
+ *
+ *******************************************************************************/
+
+#include "rtc.h"
+#include "systick.h"
+#include "system_modes.h"	/* SUCCESS/ERROR */
+#include <util/atomic.h>
+
+/*******************************************************************************
+ *                         Global Variables(Private)                           *
+ *******************************************************************************/
+
+static volatile RTC_TimeType g_time = { RTC_MONDAY, 0, 0, 0 };
+static volatile boolean g_set = FALSE; /* Time was set or restored */
+static uint32 g_second_ms = 0; /* System tick time the current second started */
+
+/*******************************************************************************
+ *                              Functions Definitions                          *
+ *******************************************************************************/
+
+void RTC_init(uint16 a_minuteOfWeek) {
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		g_second_ms = SysTick_getMillis();
+		g_time.Second = 0;
+		if (a_minuteOfWeek < RTC_MINUTES_PER_WEEK) {
+			g_time.Minute = a_minuteOfWeek % 60;
+			g_time.Hour = (a_minuteOfWeek / 60) % RTC_HOURS_PER_DAY;
+			g_time.Weekday = a_minuteOfWeek / (60 * RTC_HOURS_PER_DAY);
+			g_set = TRUE;
+		} else {
+			g_time.Minute = 0;
+			g_time.Hour = 0;
+			g_time.Weekday = RTC_MONDAY;
+			g_set = FALSE;
+		}
+	}
+}
+
+boolean RTC_update(uint32 a_millis) {
+	boolean minute = FALSE;
+	while ((uint32) (a_millis - g_second_ms) >= 1000UL) {
+		g_second_ms += 1000UL;
+		if (++g_time.Second < 60) {
+			continue;
+		}
+		g_time.Second = 0;
+		minute = TRUE;
+		if (++g_time.Minute < 60) {
+			continue;
+		}
+		g_time.Minute = 0;
+		if (++g_time.Hour < RTC_HOURS_PER_DAY) {
+			continue;
+		}
+		g_time.Hour = 0;
+		if (++g_time.Weekday == RTC_DAYS_PER_WEEK) {
+			g_time.Weekday = RTC_MONDAY;
+		}
+	}
+	return minute && g_set;
+}
+
+uint8 RTC_setTime(const RTC_TimeType *a_time) {
+	if (a_time->Weekday >= RTC_DAYS_PER_WEEK
+			|| a_time->Hour >= RTC_HOURS_PER_DAY || a_time->Minute >= 60
+			|| a_time->Second >= 60) {
+		return ERROR;
+	}
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		g_second_ms = SysTick_getMillis();
+		g_time.Weekday = a_time->Weekday;
+		g_time.Hour = a_time->Hour;
+		g_time.Minute = a_time->Minute;
+		g_time.Second = a_time->Second;
+		g_set = TRUE;
+	}
+	return SUCCESS;
+}
+
+void RTC_getTime(RTC_TimeType *a_time) {
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		a_time->Weekday = g_time.Weekday;
+		a_time->Hour = g_time.Hour;
+		a_time->Minute = g_time.Minute;
+		a_time->Second = g_time.Second;
+	}
+}
+
+uint16 RTC_getMinuteOfWeek(void) {
+	RTC_TimeType time;
+	if (!g_set) {
+		return RTC_TIME_UNKNOWN;
+	}
+	RTC_getTime(&time);
+	return ((uint16) time.Weekday * RTC_HOURS_PER_DAY + time.Hour) * 60
+			+ time.Minute;
+}
+
+boolean RTC_isSet(void) {
+	return g_set;
+}
@@ -0,0 +1,152 @@
+/******************************************************************************
+ *
+ * Module: Real Time Clock
+ *
+ * File Name: rtc.h
+ *
+ * Description: Header file for the software real time clock.
+ *
+ * 				The clock keeps the time of the week (weekday, hour, minute,
+ * 				second) and is advanced from the 1ms system tick, there is no
+ * 				crystal or battery so the time is lost on reset unless restored:
+ * 				the minute of the week is saved in the boot record (see
+ * 				storage.h) and passed back to RTC_init on the next boot. The
+ * 				clock then lags by the time the system was off, it is corrected
+ * 				by setting the time again over the link.
+ *
+ * Date Created: 18/10/2026
+ *
+ * Author: Hazem Montasser
+ *
+ *******************************************************************************/
+
+#ifndef RTC_H_
+#define RTC_H_
+
+#include "std_types.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define RTC_DAYS_PER_WEEK 		(7U)
+#define RTC_HOURS_PER_DAY 		(24U)
+#define RTC_MINUTES_PER_WEEK 	(10080U)
+#define RTC_TIME_UNKNOWN 		(0xFFFFU)	/* Minute of the week of a clock never set */
+
+/*******************************************************************************
+ *                               Types Declaration                             *
+ *******************************************************************************/
+
+typedef enum {
+	RTC_MONDAY,
+	RTC_TUESDAY,
+	RTC_WEDNESDAY,
+	RTC_THURSDAY,
+	RTC_FRIDAY,
+	RTC_SATURDAY,
+	RTC_SUNDAY
+} RTC_WeekdayType;
+
+/******************************************************************************
+ *
+ * Structure Name: RTC_TimeType
+ *
+ * Structure Description: Time of the week, also the layout of the RTC set
+ * 		frame received over the link.
+ *
+ *******************************************************************************/
+typedef struct {
+	uint8 Weekday; /* RTC_WeekdayType */
+	uint8 Hour; /* 0..23 */
+	uint8 Minute; /* 0..59 */
+	uint8 Second; /* 0..59 */
+} RTC_TimeType;
+
+/*******************************************************************************
+ *                              Functions Prototypes                           *
+ *******************************************************************************/
+
+/******************************************************************************
+ *
+ * Function Name: RTC_init
+ *
+ * Description: Starts the clock at a minute of the week saved before the
+ * 		reset, the clock is reported as not set if the saved value is
+ * 		RTC_TIME_UNKNOWN or out of range.
+ * 		---Note: The system tick must be initialized before calling this function.
+ *
+ * Args:
+ *
+ * 		[in] uint16 a_minuteOfWeek
+ * 			Minutes since Monday 00:00, or RTC_TIME_UNKNOWN.
+ * 		[out] N/A
+ * Returns: void
+ *
+ *******************************************************************************/
+void RTC_init(uint16 a_minuteOfWeek);
+
+/******************************************************************************
+ *
+ * Function Name: RTC_update
+ *
+ * Description: Advances the clock to the given system tick time, catching up
+ * 		on every second elapsed since the last call (tickless sleep).
+ * 		Called from the system tick callback.
+ *
+ * Args:
+ *
+ * 		[in] uint32 a_millis
+ * 			Current SysTick_getMillis().
+ * 		[out] N/A
+ * Returns: boolean
+ * 		TRUE if a minute was completed and the clock is set.
+ *
+ *******************************************************************************/
+boolean RTC_update(uint32 a_millis);
+
+/******************************************************************************
+ *
+ * Function Name: RTC_setTime
+ *
+ * Description: Sets the time of the week, the current second restarts.
+ *
+ * Args:
+ *
+ * 		[in] const RTC_TimeType *a_time
+ * 			New time.
+ * 		[out] N/A
+ * Returns: uint8 (SUCCESS/ERROR)
+ * 		ERROR if a field is out of range, the clock is left unchanged.
+ *
+ *******************************************************************************/
+uint8 RTC_setTime(const RTC_TimeType *a_time);
+
+/******************************************************************************
+ *
+ * Function Name: RTC_getTime
+ *
+ * Description: Copies the current time of the week.
+ *
+ * Args:
+ *
+ * 		[in] N/A
+ * 		[out] RTC_TimeType *a_time
+ * 			Current time.
+ * Returns: void
+ *
+ *******************************************************************************/
+void RTC_getTime(RTC_TimeType *a_time);
+
+/******************************************************************************
+ *
+ * Function Name: RTC_getMinuteOfWeek / RTC_isSet
+ *
+ * Description: Returns the minutes since Monday 00:00 (RTC_TIME_UNKNOWN if
+ * 		the clock is not set) / whether the clock was set or restored.
+ *
+ *******************************************************************************/
+uint16 RTC_getMinuteOfWeek(void);
+boolean RTC_isSet(void);
+
+#endif /* RTC_H_ */
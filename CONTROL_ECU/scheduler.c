@@ -0,0 +1,180 @@
+/******************************************************************************
+ *
+ * Module: Scheduler
+ *
+ * File Name: scheduler.c
+ *
+ * Description: Source file for the static-priority cooperative scheduler.
+ *
+ * Date Created: 18/10/2026
+ *
+ * Author: Hazem Montasser
+ *
+ *******************************************************************************/
+
+#include "scheduler.h"
+#include "systick.h"
+#include <util/atomic.h>
+
+/*******************************************************************************
+ *                               Types Declaration                             *
+ *******************************************************************************/
+
+/* Task control block */
+typedef struct {
+	void (*Task)(uint8 a_events);
+	uint16 Period_ms; /* 0 = event driven only */
+	uint32 Release; /* Next SCHED_EVENT_PERIOD, in system tick ms */
+	volatile uint8 Events; /* Pending event flags */
+	Sched_StatsType Stats;
+} Sched_TcbType;
+
+/*******************************************************************************
+ *                         Global Variables(Private)                           *
+ *******************************************************************************/
+
+static Sched_TcbType g_tcb[SCHED_MAX_TASKS];
+static void (*g_Sched_idleCallback)(void) = NULL_PTR;
+
+/*******************************************************************************
+ *                      Functions Definitions (Private)                        *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Sets SCHED_EVENT_PERIOD of every periodic task whose release time passed.
+ * A task late by more than one period is released once, not once per period.
+ */
+static void sched_releasePeriodic(void) {
+	uint32 now = SysTick_getMillis();
+	for (uint8 i = 0; i < SCHED_MAX_TASKS; i++) {
+		if (g_tcb[i].Task != NULL_PTR && g_tcb[i].Period_ms != 0
+				&& (sint32) (now - g_tcb[i].Release) >= 0) {
+			g_tcb[i].Release += g_tcb[i].Period_ms;
+			if ((sint32) (now - g_tcb[i].Release) >= 0) {
+				g_tcb[i].Release = now + g_tcb[i].Period_ms;
+			}
+			Sched_setEvent(i, SCHED_EVENT_PERIOD);
+		}
+	}
+}
+
+/*
+ * Description :
+ * Runs one step of the given task and accounts its run time.
+ */
+static void sched_runTask(Sched_TcbType *a_tcb) {
+	uint8 events;
+	uint32 start;
+	uint32 elapsed;
+
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		events = a_tcb->Events;
+		a_tcb->Events = 0;
+	}
+	start = SysTick_getMicros();
+	a_tcb->Task(events);
+	elapsed = SysTick_getMicros() - start;
+
+	a_tcb->Stats.RunCount++;
+	a_tcb->Stats.TotalTime_us += elapsed;
+	if (elapsed > a_tcb->Stats.MaxTime_us) {
+		a_tcb->Stats.MaxTime_us = (elapsed > 0xFFFF) ? 0xFFFF : elapsed;
+	}
+}
+
+/*******************************************************************************
+ *                              Functions Definitions                          *
+ *******************************************************************************/
+
+void Sched_init(void) {
+	for (uint8 i = 0; i < SCHED_MAX_TASKS; i++) {
+		g_tcb[i].Task = NULL_PTR;
+		g_tcb[i].Period_ms = 0;
+		g_tcb[i].Events = 0;
+		g_tcb[i].Stats.RunCount = 0;
+		g_tcb[i].Stats.TotalTime_us = 0;
+		g_tcb[i].Stats.MaxTime_us = 0;
+	}
+}
+
+void Sched_addTask(uint8 a_priority, void (*a_ptrToTask)(uint8 a_events),
+		uint16 a_period_ms) {
+	if (a_priority < SCHED_MAX_TASKS) {
+		g_tcb[a_priority].Period_ms = a_period_ms;
+		g_tcb[a_priority].Release = SysTick_getMillis() + a_period_ms;
+		g_tcb[a_priority].Task = a_ptrToTask;
+	}
+}
+
+void Sched_setPeriod(uint8 a_priority, uint16 a_period_ms) {
+	if (a_priority < SCHED_MAX_TASKS) {
+		g_tcb[a_priority].Period_ms = a_period_ms;
+		g_tcb[a_priority].Release = SysTick_getMillis() + a_period_ms;
+	}
+}
+
+void Sched_setEvent(uint8 a_priority, uint8 a_events) {
+	if (a_priority < SCHED_MAX_TASKS) {
+		ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+		{
+			g_tcb[a_priority].Events |= a_events;
+		}
+	}
+}
+
+void Sched_setIdleCallback(void (*a_ptrToCallback)(void)) {
+	g_Sched_idleCallback = a_ptrToCallback;
+}
+
+boolean Sched_isIdle(void) {
+	for (uint8 i = 0; i < SCHED_MAX_TASKS; i++) {
+		if (g_tcb[i].Task != NULL_PTR && g_tcb[i].Events != 0) {
+			return FALSE;
+		}
+	}
+	return TRUE;
+}
+
+uint32 Sched_getIdleTime(void) {
+	uint32 now = SysTick_getMillis();
+	uint32 idle = SCHED_IDLE_FOREVER;
+	sint32 left;
+	for (uint8 i = 0; i < SCHED_MAX_TASKS; i++) {
+		if (g_tcb[i].Task != NULL_PTR && g_tcb[i].Period_ms != 0) {
+			left = (sint32) (g_tcb[i].Release - now);
+			if (left <= 0) {
+				return 0;
+			}
+			if ((uint32) left < idle) {
+				idle = left;
+			}
+		}
+	}
+	return idle;
+}
+
+void Sched_start(void) {
+	uint8 i;
+	for (;;) {
+		sched_releasePeriodic();
+		/* Highest priority ready task, one step only, then re-evaluate */
+		for (i = 0; i < SCHED_MAX_TASKS; i++) {
+			if (g_tcb[i].Task != NULL_PTR && g_tcb[i].Events != 0) {
+				sched_runTask(&g_tcb[i]);
+				break;
+			}
+		}
+		if (i == SCHED_MAX_TASKS && g_Sched_idleCallback != NULL_PTR) {
+			(*g_Sched_idleCallback)();
+		}
+	}
+}
+
+void Sched_getStats(uint8 a_priority, Sched_StatsType *a_stats) {
+	/* Only updated from Sched_start, no need to lock */
+	if (a_priority < SCHED_MAX_TASKS) {
+		*a_stats = g_tcb[a_priority].Stats;
+	}
+}
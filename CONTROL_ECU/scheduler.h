@@ -0,0 +1,200 @@
+/******************************************************************************
+ *
+ * Module: Scheduler
+ *
+ * File Name: scheduler.h
+ *
+ * Description: Header file for the static-priority cooperative scheduler.
+ *
+ * 				Tasks are run-to-completion functions, each owning one statically
+ * 				allocated task control block whose index is its priority (0 is
+ * 				the highest). A task is ready when any of its event flags is set,
+ * 				either by Sched_setEvent (safe from ISR's) or by its period
+ * 				elapsing on the system tick (SCHED_EVENT_PERIOD).
+ *
+ * 				Sched_start always runs the highest priority ready task, so the
+ * 				response time of a task is bounded by the longest single step of
+ * 				any task, not by the longest wait.
+ *
+ * Date Created: 18/10/2026
+ *
+ * Author: Hazem Montasser
+ *
+ *******************************************************************************/
+
+#ifndef SCHEDULER_H_
+#define SCHEDULER_H_
+
+#include "std_types.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define SCHED_MAX_TASKS 		(6U)	/* Task control blocks = priority levels */
+#define SCHED_EVENT_PERIOD 		(0x80)	/* Set when the task period elapses */
+#define SCHED_IDLE_FOREVER 		(0xFFFFFFFFUL)	/* Sched_getIdleTime: no periodic task */
+
+/*******************************************************************************
+ *                               Types Declaration                             *
+ *******************************************************************************/
+
+/******************************************************************************
+ *
+ * Structure Name: Sched_StatsType
+ *
+ * Structure Description: Run-time accounting of one task, measured on the
+ * 		system tick clock (4us resolution at 8MHz).
+ *
+ *******************************************************************************/
+typedef struct {
+	uint32 RunCount; /* Completed task steps */
+	uint32 TotalTime_us; /* Sum of step times, mean = TotalTime_us / RunCount */
+	uint16 MaxTime_us; /* Longest step */
+} Sched_StatsType;
+
+/*******************************************************************************
+ *                              Functions Prototypes                           *
+ *******************************************************************************/
+
+/******************************************************************************
+ *
+ * Function Name: Sched_init
+ *
+ * Description: Clears all task control blocks.
+ * Args: void
+ * Returns: void
+ *******************************************************************************/
+void Sched_init(void);
+
+/******************************************************************************
+ *
+ * Function Name: Sched_addTask
+ *
+ * Description: Registers a task at the given priority.
+ *
+ * Args:
+ *
+ * 		[in] uint8 a_priority
+ * 			Task control block index, 0 (highest) to SCHED_MAX_TASKS - 1.
+ * 			 void (*a_ptrToTask)(uint8 a_events)
+ * 			Task step, called with the events which made it ready (cleared
+ * 			before the call).
+ * 			 uint16 a_period_ms
+ * 			Period of SCHED_EVENT_PERIOD, 0 for a purely event driven task.
+ * 		[out] N/A
+ * Returns: void
+ *
+ *******************************************************************************/
+void Sched_addTask(uint8 a_priority, void (*a_ptrToTask)(uint8 a_events),
+		uint16 a_period_ms);
+
+/******************************************************************************
+ *
+ * Function Name: Sched_setPeriod
+ *
+ * Description: Changes the period of a task, the next SCHED_EVENT_PERIOD is
+ * 		a_period_ms from now. A task with nothing to do can set 0 so it does
+ * 		not keep the CPU out of idle sleep.
+ *
+ * Args:
+ *
+ * 		[in] uint8 a_priority
+ * 			Task to change.
+ * 			 uint16 a_period_ms
+ * 			New period, 0 for event driven only.
+ * 		[out] N/A
+ *
+ * Returns: void
+ *
+ *******************************************************************************/
+void Sched_setPeriod(uint8 a_priority, uint16 a_period_ms);
+
+/******************************************************************************
+ *
+ * Function Name: Sched_setEvent
+ *
+ * Description: Sets event flags of a task, making it ready.
+ * 		---Note: Safe to call from an interrupt.
+ *
+ * Args:
+ *
+ * 		[in] uint8 a_priority
+ * 			Task to signal.
+ * 			 uint8 a_events
+ * 			Event flags to set (application defined, except SCHED_EVENT_PERIOD).
+ * 		[out] N/A
+ * Returns: void
+ *
+ *******************************************************************************/
+void Sched_setEvent(uint8 a_priority, uint8 a_events);
+
+/******************************************************************************
+ *
+ * Function Name: Sched_setIdleCallback
+ *
+ * Description: Sets a function called whenever no task is ready.
+ * Args:
+ * 		[in] void (*a_ptrToCallback)(void)
+ * 			Pointer to the callback function.
+ * 		[out] N/A
+ * Returns: void
+ *******************************************************************************/
+void Sched_setIdleCallback(void (*a_ptrToCallback)(void));
+
+/******************************************************************************
+ *
+ * Function Name: Sched_isIdle
+ *
+ * Description: Returns TRUE if no task has a pending event.
+ * 		---Note: Call with interrupts disabled right before sleeping, so that
+ * 		an event set by an interrupt is not missed.
+ *
+ * Args: void
+ *
+ * Returns: boolean
+ *
+ *******************************************************************************/
+boolean Sched_isIdle(void);
+
+/******************************************************************************
+ *
+ * Function Name: Sched_getIdleTime
+ *
+ * Description: Returns the milliseconds until the next periodic release, 0 if
+ * 		one is due and SCHED_IDLE_FOREVER if no task is periodic.
+ *
+ * Args: void
+ *
+ * Returns: uint32
+ *
+ *******************************************************************************/
+uint32 Sched_getIdleTime(void);
+
+/******************************************************************************
+ *
+ * Function Name: Sched_start
+ *
+ * Description: Runs the ready tasks forever, highest priority first.
+ * 		---Note: SysTick_init must be called and interrupts enabled first.
+ * Args: void
+ * Returns: void (never returns)
+ *******************************************************************************/
+void Sched_start(void);
+
+/******************************************************************************
+ *
+ * Function Name: Sched_getStats
+ *
+ * Description: Copies the run-time accounting of a task into a_stats.
+ *
+ * Args:
+ *
+ * 		[in] uint8 a_priority
+ * 		[out] Sched_StatsType *a_stats
+ * Returns: void
+ *
+ *******************************************************************************/
+void Sched_getStats(uint8 a_priority, Sched_StatsType *a_stats);
+
+#endif /* SCHEDULER_H_ */
@@ -0,0 +1,445 @@
+/******************************************************************************
+ *
+ * Module: Storage
+ *
+ * File Name: storage.c
+ *
+ * Description: Source file for the tiered persistent storage layer.
+ *
+ * Date Created: 18/10/2026
+ *
+ * Author: Hazem Montasser
+ *
+ *******************************************************************************/
+
+#include "storage.h"
+#include "internal_eeprom.h"
+#include "external_eeprom.h"
+#include "timeout.h"
+#include "systick.h"		/* To time the accesses */
+#include "config.h"			/* For the configuration block size */
+#include "access.h"			/* For the access windows size */
+#include "system_modes.h"	/* For PASSWORD_LENGTH */
+
+/*******************************************************************************
+ *                               Types Declaration                             *
+ *******************************************************************************/
+
+/* Placement of one record */
+typedef struct {
+	Storage_TierType Tier;
+	uint16 Address; /* Start address inside the tier */
+	uint16 Size; /* Record size in bytes */
+	boolean Critical; /* Written first when the supply is marginal */
+} Storage_RecordType;
+
+/* Write waiting in the write-behind queue */
+typedef struct {
+	uint8 Key; /* Storage_KeyType */
+	uint8 Offset; /* Offset inside the record */
+	uint8 Size; /* Bytes to write */
+	uint8 Done; /* Bytes already programmed */
+	uint8 Retries; /* Failed attempts so far */
+	boolean Busy; /* The EEPROM did not acknowledge, Deadline is running */
+	Timeout_DeadlineType Deadline; /* End of the current busy wait */
+	uint8 Data[STORAGE_QUEUE_DATA_SIZE];
+} Storage_PendingType;
+
+/*******************************************************************************
+ *                         Global Variables(Private)                           *
+ *******************************************************************************/
+
+/* Key table, indexed by Storage_KeyType */
+static const Storage_RecordType g_records[STORAGE_KEY_COUNT] = {
+/*	 Tier					Address	Size								Critical */
+	{ STORAGE_TIER_INTERNAL, 0x0000, sizeof(Storage_BootRecordType), FALSE },
+	{ STORAGE_TIER_INTERNAL, 0x000A, 1, FALSE },
+	{ STORAGE_TIER_EXTERNAL, 0x0320, PASSWORD_LENGTH - 2, TRUE },
+	{ STORAGE_TIER_EXTERNAL, 0x0400,
+			STORAGE_AUDIT_ENTRIES * sizeof(Storage_AuditRecordType), FALSE },
+	{ STORAGE_TIER_EXTERNAL, 0x0500, CONFIG_BLOCK_SIZE, TRUE },
+	{ STORAGE_TIER_EXTERNAL, 0x0600, ACCESS_WINDOWS_SIZE, TRUE } };
+
+static Storage_BootRecordType g_boot_record;
+static uint8 g_audit_head = 0; /* Next audit log slot */
+static Storage_TierInfoType g_tier_info[STORAGE_TIER_COUNT];
+/* Write in flight per tier, timed until the tier is seen ready again */
+static uint32 g_write_start_us[STORAGE_TIER_COUNT];
+static uint8 g_write_size[STORAGE_TIER_COUNT]; /* 0: none */
+
+/* Write-behind queue (FIFO ring), drained in order so a later write is
+ * never durable before an earlier one */
+static Storage_PendingType g_queue[STORAGE_QUEUE_DEPTH];
+static uint8 g_queue_head = 0;
+static uint8 g_queue_count = 0;
+static boolean g_external_written = FALSE; /* External write cycle may be running */
+static volatile boolean g_supply_marginal = FALSE; /* Set by the supply monitor */
+
+/*******************************************************************************
+ *                      Functions Definitions (Private)                        *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Validates key & range and returns the absolute address inside the tier.
+ */
+static boolean storage_locate(Storage_KeyType a_key, uint8 a_offset,
+		uint8 a_size, uint16 *a_addr) {
+	if (a_key >= STORAGE_KEY_COUNT
+			|| (uint16) a_offset + a_size > g_records[a_key].Size) {
+		return FALSE;
+	}
+	*a_addr = g_records[a_key].Address + a_offset;
+	return TRUE;
+}
+
+/*
+ * Description :
+ * Adds a sample of the time per byte of an access started at a_start_us to a
+ * latency figure, averaged over the last few samples (the first one is kept).
+ */
+static void storage_measure(uint16 *a_latency, uint32 a_start_us,
+		uint8 a_size) {
+	uint32 sample;
+	if (a_size == 0) {
+		return;
+	}
+	sample = (SysTick_getMicros() - a_start_us) / a_size;
+	if (sample > 0xFFFFU) {
+		sample = 0xFFFFU;
+	}
+	if (*a_latency == 0) {
+		*a_latency = (uint16) sample;
+	} else {
+		*a_latency = (uint16) ((3UL * *a_latency + sample) >> 2);
+	}
+}
+
+/*
+ * Description :
+ * Called when a tier is seen ready: ends the timing of its write in flight.
+ */
+static void storage_writeDone(Storage_TierType a_tier) {
+	if (g_write_size[a_tier] != 0) {
+		storage_measure(&g_tier_info[a_tier].WriteLatency_us,
+				g_write_start_us[a_tier], g_write_size[a_tier]);
+		g_write_size[a_tier] = 0;
+	}
+}
+
+/*
+ * Description :
+ * Starts timing a write of a_size bytes just issued to a tier.
+ */
+static void storage_writeIssued(Storage_TierType a_tier, uint8 a_size) {
+	g_write_start_us[a_tier] = SysTick_getMicros();
+	g_write_size[a_tier] = a_size;
+}
+
+/*
+ * Description :
+ * Adds one chunk (at most STORAGE_QUEUE_DATA_SIZE bytes) to the queue tail,
+ * merging it into the last record if it rewrites the same bytes.
+ */
+static void storage_enqueue(Storage_KeyType a_key, uint8 a_offset,
+		const uint8 *a_data, uint8 a_size) {
+	Storage_PendingType *record;
+	if (g_queue_count != 0) {
+		record = &g_queue[(g_queue_head + g_queue_count - 1)
+				% STORAGE_QUEUE_DEPTH];
+		if ((record->Key == a_key) && (record->Offset == a_offset)
+				&& (record->Size == a_size) && (record->Done == 0)) {
+			for (uint8 i = 0; i < a_size; i++) {
+				record->Data[i] = a_data[i];
+			}
+			return;
+		}
+	}
+	/* Queue full: make room by draining, ends since the head record is
+	 * bounded by its retries */
+	while (g_queue_count == STORAGE_QUEUE_DEPTH) {
+		Storage_service();
+	}
+	record = &g_queue[(g_queue_head + g_queue_count) % STORAGE_QUEUE_DEPTH];
+	record->Key = a_key;
+	record->Offset = a_offset;
+	record->Size = a_size;
+	record->Done = 0;
+	record->Retries = 0;
+	record->Busy = FALSE;
+	for (uint8 i = 0; i < a_size; i++) {
+		record->Data[i] = a_data[i];
+	}
+	g_queue_count++;
+}
+
+/*
+ * Description :
+ * Removes the head record from the queue.
+ */
+static void storage_dequeue(void) {
+	g_queue_head = (g_queue_head + 1) % STORAGE_QUEUE_DEPTH;
+	g_queue_count--;
+}
+
+/*
+ * Description :
+ * Returns TRUE if a write of the given key is still queued.
+ */
+static boolean storage_isPending(Storage_KeyType a_key) {
+	for (uint8 i = 0; i < g_queue_count; i++) {
+		if (g_queue[(g_queue_head + i) % STORAGE_QUEUE_DEPTH].Key == a_key) {
+			return TRUE;
+		}
+	}
+	return FALSE;
+}
+
+/*
+ * Description :
+ * Performs one write step of a record: one byte of the internal tier or one
+ * page chunk of the external tier. Returns at once if the EEPROM is busy.
+ * A busy external EEPROM is a failed attempt once it has not acknowledged for
+ * EEPROM_WRITE_CYCLE_MS, so a missing or dead device can't stall the queue:
+ * every record completes or is dropped after STORAGE_WRITE_RETRIES attempts.
+ */
+static void storage_step(Storage_PendingType *record) {
+	Storage_TierType tier;
+	uint16 addr;
+	uint8 chunk;
+	uint8 status;
+
+	tier = g_records[record->Key].Tier;
+	addr = g_records[record->Key].Address + record->Offset + record->Done;
+
+	if (tier == STORAGE_TIER_INTERNAL) {
+		/* One byte per step, only once the previous byte is programmed */
+		if (!IEEPROM_isReady()) {
+			return;
+		}
+		storage_writeDone(tier);
+		status = IEEPROM_writeByte(addr, record->Data[record->Done]);
+		chunk = 1;
+	} else {
+		/* Rest of the record up to the page boundary in one write cycle */
+		chunk = EEPROM_PAGE_SIZE - (addr % EEPROM_PAGE_SIZE);
+		if (chunk > record->Size - record->Done) {
+			chunk = record->Size - record->Done;
+		}
+		status = EEPROM_writePage(addr, &record->Data[record->Done], chunk);
+		if (status == EEPROM_BUSY) {
+			/* Busy during a write cycle is expected, longer is a failure */
+			if (!record->Busy) {
+				record->Busy = TRUE;
+				Timeout_start(&record->Deadline, EEPROM_WRITE_CYCLE_MS);
+				return;
+			}
+			if (Timeout_check(&record->Deadline, TIMEOUT_SITE_EEPROM_READY)
+					== TIMEOUT_STATUS_OK) {
+				return;
+			}
+			status = ERROR;
+		} else {
+			/* Acknowledged: the previous write cycle is over */
+			storage_writeDone(tier);
+		}
+		record->Busy = FALSE;
+		g_external_written = TRUE;
+	}
+
+	if (status == SUCCESS) {
+		storage_writeIssued(tier, chunk);
+		record->Done += chunk;
+		g_tier_info[tier].BytesWritten += chunk;
+	} else if (++record->Retries >= STORAGE_WRITE_RETRIES) {
+		/* Give up on this record so the queue keeps moving */
+		g_tier_info[tier].WriteErrors++;
+		record->Done = record->Size;
+	}
+}
+
+/*
+ * Description :
+ * Power-fail path: programs every queued critical record to completion,
+ * oldest first, ahead of the non-critical ones. Records of the same key keep
+ * their order since they are all critical or all not. A record the EEPROM
+ * never acknowledges is dropped by storage_step after STORAGE_WRITE_RETRIES
+ * write cycle deadlines, so the flush takes at most that long per record.
+ */
+static void storage_flushCritical(void) {
+	Storage_PendingType *record;
+	for (uint8 i = 0; i < g_queue_count; i++) {
+		record = &g_queue[(g_queue_head + i) % STORAGE_QUEUE_DEPTH];
+		if (g_records[record->Key].Critical) {
+			while (record->Done < record->Size) {
+				storage_step(record);
+			}
+		}
+	}
+}
+
+/*******************************************************************************
+ *                              Functions Definitions                          *
+ *******************************************************************************/
+
+uint8 Storage_init(uint8 a_resetCause) {
+	uint8 status;
+	g_queue_head = 0;
+	g_queue_count = 0;
+	Storage_read(STORAGE_KEY_BOOT_RECORD, 0, (uint8*) &g_boot_record,
+			sizeof(g_boot_record));
+	/* Erased or foreign content: start a new record and a new audit log */
+	if (g_boot_record.Magic != STORAGE_BOOT_MAGIC) {
+		g_boot_record.Magic = STORAGE_BOOT_MAGIC;
+		g_boot_record.BootCount = 0;
+		g_boot_record.Clock = 0xFFFF;
+		g_audit_head = 0;
+		Storage_write(STORAGE_KEY_AUDIT_HEAD, 0, &g_audit_head, 1);
+	} else {
+		Storage_read(STORAGE_KEY_AUDIT_HEAD, 0, &g_audit_head, 1);
+		if (g_audit_head >= STORAGE_AUDIT_ENTRIES) {
+			g_audit_head = 0;
+		}
+	}
+	g_boot_record.BootCount++;
+	g_boot_record.ResetCause = a_resetCause;
+	status = Storage_write(STORAGE_KEY_BOOT_RECORD, 0,
+			(const uint8*) &g_boot_record, sizeof(g_boot_record));
+	Storage_logEvent(AUDIT_EVENT_BOOT, a_resetCause);
+	return status;
+}
+
+uint8 Storage_read(Storage_KeyType a_key, uint8 a_offset, uint8 *a_data,
+		uint8 a_size) {
+	uint16 addr;
+	uint8 status;
+	uint32 start_us;
+	if (!storage_locate(a_key, a_offset, a_size, &addr)) {
+		return ERROR;
+	}
+	/* Shed TWI reads, the bus belongs to the power-fail flush */
+	if (g_supply_marginal && g_records[a_key].Tier == STORAGE_TIER_EXTERNAL) {
+		return ERROR;
+	}
+	/* Read-your-writes: the EEPROM must hold the queued bytes first */
+	if (storage_isPending(a_key)) {
+		Storage_flush();
+	}
+	start_us = SysTick_getMicros();
+	if (g_records[a_key].Tier == STORAGE_TIER_INTERNAL) {
+		status = IEEPROM_readString(addr, a_data, a_size);
+	} else {
+		status = EEPROM_readString(addr, a_data, a_size);
+	}
+	if (status == SUCCESS) {
+		storage_measure(&g_tier_info[g_records[a_key].Tier].ReadLatency_us,
+				start_us, a_size);
+	}
+	g_tier_info[g_records[a_key].Tier].BytesRead += a_size;
+	return status;
+}
+
+uint8 Storage_write(Storage_KeyType a_key, uint8 a_offset, const uint8 *a_data,
+		uint8 a_size) {
+	uint16 addr;
+	uint8 chunk;
+	if (!storage_locate(a_key, a_offset, a_size, &addr)) {
+		return ERROR;
+	}
+	/* Split long writes into queue records */
+	while (a_size > 0) {
+		chunk = (a_size > STORAGE_QUEUE_DATA_SIZE) ?
+				STORAGE_QUEUE_DATA_SIZE : a_size;
+		storage_enqueue(a_key, a_offset, a_data, chunk);
+		a_offset += chunk;
+		a_data += chunk;
+		a_size -= chunk;
+	}
+	return SUCCESS;
+}
+
+void Storage_service(void) {
+	Storage_PendingType *record;
+
+	if (g_supply_marginal) {
+		storage_flushCritical();
+	}
+	if (g_queue_count == 0) {
+		return;
+	}
+	record = &g_queue[g_queue_head];
+	/* Critical records may already be done out of order */
+	if (record->Done < record->Size) {
+		storage_step(record);
+	}
+	if (record->Done == record->Size) {
+		storage_dequeue();
+	}
+}
+
+void Storage_flush(void) {
+	while (g_queue_count != 0) {
+		Storage_service();
+	}
+	/* Wait for the last write cycles to complete */
+	while (!IEEPROM_isReady())
+		;
+	storage_writeDone(STORAGE_TIER_INTERNAL);
+	if (g_external_written) {
+		Timeout_DeadlineType deadline;
+		Timeout_start(&deadline, EEPROM_WRITE_CYCLE_MS);
+		while (!EEPROM_isReady()) {
+			if (Timeout_check(&deadline, TIMEOUT_SITE_EEPROM_READY)
+					!= TIMEOUT_STATUS_OK) {
+				/* No figure from a write cycle which never ended */
+				g_write_size[STORAGE_TIER_EXTERNAL] = 0;
+				break;
+			}
+		}
+		storage_writeDone(STORAGE_TIER_EXTERNAL);
+		g_external_written = FALSE;
+	}
+}
+
+void Storage_setSupplyMarginal(boolean a_marginal) {
+	g_supply_marginal = a_marginal;
+}
+
+uint8 Storage_pending(void) {
+	return g_queue_count;
+}
+
+uint8 Storage_logEvent(Storage_AuditEventType a_event, uint8 a_arg) {
+	Storage_AuditRecordType record;
+	uint8 status;
+	record.Event = a_event;
+	record.Arg = a_arg;
+	record.BootCount = g_boot_record.BootCount;
+	status = Storage_write(STORAGE_KEY_AUDIT_LOG,
+			g_audit_head * sizeof(Storage_AuditRecordType),
+			(const uint8*) &record, sizeof(record));
+	/* Advance the ring head, oldest record gets overwritten next */
+	g_audit_head = (g_audit_head + 1) % STORAGE_AUDIT_ENTRIES;
+	Storage_write(STORAGE_KEY_AUDIT_HEAD, 0, &g_audit_head, 1);
+	return status;
+}
+
+uint8 Storage_saveClock(uint16 a_minuteOfWeek) {
+	g_boot_record.Clock = a_minuteOfWeek;
+	return Storage_write(STORAGE_KEY_BOOT_RECORD, 0,
+			(const uint8*) &g_boot_record, sizeof(g_boot_record));
+}
+
+const Storage_BootRecordType* Storage_getBootRecord(void) {
+	return &g_boot_record;
+}
+
+Storage_TierType Storage_getTier(Storage_KeyType a_key) {
+	return g_records[a_key].Tier;
+}
+
+void Storage_getTierInfo(Storage_TierType a_tier, Storage_TierInfoType *a_info) {
+	if (a_tier < STORAGE_TIER_COUNT) {
+		*a_info = g_tier_info[a_tier];
+	}
+}
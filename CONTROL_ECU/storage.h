@@ -0,0 +1,304 @@
+/******************************************************************************
+ *
+ * Module: Storage
+ *
+ * File Name: storage.h
+ *
+ * Description: Header file for the tiered persistent storage layer.
+ * 				Every persistent record is addressed by a key, the key decides
+ * 				which tier holds it:
+ * 				 - Internal tier: ATmega16 on-chip EEPROM (512B), for small hot
+ * 				   records read at boot (boot record, audit log head).
+ * 				 - External tier: M24C16 over TWI (2KB), for bulk data such as
+ * 				   credentials and the audit log.
+ *
+ * 				Writes are write-behind: Storage_write copies the bytes into a
+ * 				small queue and returns, Storage_service programs the queue one
+ * 				step at a time (never waiting on a busy EEPROM) and
+ * 				Storage_flush is the barrier which makes everything durable.
+ *
+ * 				When the supply monitor reports a marginal supply, critical
+ * 				records (credentials, configuration and access windows) are
+ * 				programmed ahead of the queue order, and external reads are
+ * 				refused so the TWI bus is left to the flush.
+ *
+ * Date Created: 18/10/2026
+ *
+ * Author: Hazem Montasser
+ *
+ *******************************************************************************/
+
+#ifndef STORAGE_H_
+#define STORAGE_H_
+
+#include "std_types.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define STORAGE_BOOT_MAGIC 			(0xA5)	/* Marks a valid boot record */
+#define STORAGE_AUDIT_ENTRIES 		(64U)	/* Audit log ring size in records */
+#define STORAGE_QUEUE_DEPTH 		(6U)	/* Pending write records */
+#define STORAGE_QUEUE_DATA_SIZE 	(8U)	/* Bytes per pending record, longer writes are split */
+#define STORAGE_WRITE_RETRIES 		(3U)	/* Failed attempts before a pending record is dropped */
+
+
+/*******************************************************************************
+ *                               Types Declaration                             *
+ *******************************************************************************/
+
+/* Storage tiers */
+typedef enum {
+	STORAGE_TIER_INTERNAL, STORAGE_TIER_EXTERNAL, STORAGE_TIER_COUNT
+} Storage_TierType;
+
+/* Persistent records, see the key table in storage.c for placement */
+typedef enum {
+	STORAGE_KEY_BOOT_RECORD, /* Internal: Storage_BootRecordType */
+	STORAGE_KEY_AUDIT_HEAD, /* Internal: uint8 next audit log slot */
+	STORAGE_KEY_PASSWORD, /* External: password characters */
+	STORAGE_KEY_AUDIT_LOG, /* External: ring of Storage_AuditRecordType */
+	STORAGE_KEY_CONFIG, /* External: configuration index block (config.h) */
+	STORAGE_KEY_ACCESS_WINDOWS, /* External: weekly access windows (access.h) */
+	STORAGE_KEY_COUNT
+} Storage_KeyType;
+
+/* Events recorded in the audit log */
+typedef enum {
+	AUDIT_EVENT_BOOT,
+	AUDIT_EVENT_PASSWORD_SET,
+	AUDIT_EVENT_ATTEMPT_FAILED,
+	AUDIT_EVENT_ALARM,
+	AUDIT_EVENT_DOOR_OPENED,
+	AUDIT_EVENT_ACCESS_DENIED,
+	AUDIT_EVENT_DOOR_ABORTED /* Arg: door step without a timer to end it */
+} Storage_AuditEventType;
+
+/******************************************************************************
+ *
+ * Structure Name: Storage_BootRecordType
+ *
+ * Structure Description: Record kept in the internal tier and updated on
+ * 		every reset.
+ *
+ *******************************************************************************/
+typedef struct {
+	uint8 Magic; /* STORAGE_BOOT_MAGIC when the record is valid */
+	uint16 BootCount; /* Number of resets since the record was created */
+	uint8 ResetCause; /* MCUCSR flags of the last reset */
+	uint16 Clock; /* RTC minute of the week at the last save, 0xFFFF if never set */
+} Storage_BootRecordType;
+
+/******************************************************************************
+ *
+ * Structure Name: Storage_AuditRecordType
+ *
+ * Structure Description: One audit log entry.
+ *
+ *******************************************************************************/
+typedef struct {
+	uint8 Event; /* Storage_AuditEventType */
+	uint8 Arg; /* Event specific argument (mode, attempt no., ...) */
+	uint16 BootCount; /* Boot in which the event happened */
+} Storage_AuditRecordType;
+
+/******************************************************************************
+ *
+ * Structure Name: Storage_TierInfoType
+ *
+ * Structure Description: Latency and traffic figures reported per tier.
+ *
+ *******************************************************************************/
+typedef struct {
+	uint16 ReadLatency_us; /* Measured read time per byte, 0 until measured */
+	uint16 WriteLatency_us; /* Measured time per byte from a write to the tier being ready again */
+	uint32 BytesRead; /* Bytes read since reset */
+	uint32 BytesWritten; /* Bytes written since reset */
+	uint16 WriteErrors; /* Pending records dropped after STORAGE_WRITE_RETRIES */
+} Storage_TierInfoType;
+
+/*******************************************************************************
+ *                              Functions Prototypes                           *
+ *******************************************************************************/
+
+/******************************************************************************
+ *
+ * Function Name: Storage_init
+ *
+ * Description: Loads (or creates) the boot record, increments the boot count,
+ * 		stores the reset cause and logs a boot event.
+ * 		---Note: TWI must be initialized before calling this function.
+ *
+ * Args:
+ *
+ * 		[in] uint8 a_resetCause
+ * 			MCUCSR reset flags read at startup.
+ * 		[out] N/A
+ * Returns: uint8 (SUCCESS/ERROR)
+ *
+ *******************************************************************************/
+uint8 Storage_init(uint8 a_resetCause);
+
+/******************************************************************************
+ *
+ * Function Name: Storage_read
+ *
+ * Description: Reads part of a record from whichever tier holds it.
+ * 		Pending writes of the same record are flushed first.
+ * 		Reads of the external tier fail while the supply is marginal.
+ *
+ * Args:
+ *
+ * 		[in] Storage_KeyType a_key
+ * 			Record to read.
+ * 			 uint8 a_offset
+ * 			Offset inside the record.
+ * 			 uint8 a_size
+ * 			Number of bytes, a_offset + a_size must not exceed the record size.
+ * 		[out] uint8 *a_data
+ * 			Buffer receiving the bytes.
+ * Returns: uint8 (SUCCESS/ERROR)
+ *
+ *******************************************************************************/
+uint8 Storage_read(Storage_KeyType a_key, uint8 a_offset, uint8 *a_data,
+		uint8 a_size);
+
+/******************************************************************************
+ *
+ * Function Name: Storage_write
+ *
+ * Description: Queues a write of part of a record to whichever tier holds it
+ * 		and returns without waiting for the EEPROM.
+ * 		If the write is identical in key, offset and size to the last queued
+ * 		record which has not started yet, that record is updated instead.
+ * 		---Note: Blocks only if the queue is full, until a record is drained.
+ *
+ * Args:
+ *
+ * 		[in] Storage_KeyType a_key
+ * 			Record to write.
+ * 			 uint8 a_offset
+ * 			Offset inside the record.
+ * 			 const uint8 *a_data
+ * 			Bytes to write.
+ * 			 uint8 a_size
+ * 			Number of bytes, a_offset + a_size must not exceed the record size.
+ * 		[out] N/A
+ * Returns: uint8 (SUCCESS/ERROR)
+ *
+ *******************************************************************************/
+uint8 Storage_write(Storage_KeyType a_key, uint8 a_offset, const uint8 *a_data,
+		uint8 a_size);
+
+/******************************************************************************
+ *
+ * Function Name: Storage_service
+ *
+ * Description: Performs one step of the pending writes: one byte of the
+ * 		internal tier or one page chunk of the external tier. Returns at once
+ * 		if the target EEPROM is still in its write cycle.
+ * 		Meant to be called from idle loops (e.g. UART idle callback).
+ * Args: void
+ * Returns: void
+ *******************************************************************************/
+void Storage_service(void);
+
+/******************************************************************************
+ *
+ * Function Name: Storage_flush
+ *
+ * Description: Barrier: drains the queue and waits until the last write cycle
+ * 		of both tiers has completed, so every write issued before the call is
+ * 		durable when it returns.
+ * Args: void
+ * Returns: void
+ *******************************************************************************/
+void Storage_flush(void);
+
+/******************************************************************************
+ *
+ * Function Name: Storage_setSupplyMarginal
+ *
+ * Description: Switches the queue to the power-fail policy: while marginal,
+ * 		the next Storage_service call programs every queued critical record to
+ * 		completion before resuming the normal order, and Storage_read of the
+ * 		external tier returns ERROR.
+ * 		---Note: Only sets a flag, safe to call from an interrupt.
+ *
+ * Args:
+ *
+ * 		[in] boolean a_marginal
+ * 			TRUE while the supply is below the warning threshold.
+ * 		[out] N/A
+ * Returns: void
+ *
+ *******************************************************************************/
+void Storage_setSupplyMarginal(boolean a_marginal);
+
+/******************************************************************************
+ *
+ * Function Name: Storage_pending
+ *
+ * Description: Returns the number of queued write records.
+ * Args: void
+ * Returns: uint8
+ *******************************************************************************/
+uint8 Storage_pending(void);
+
+/******************************************************************************
+ *
+ * Function Name: Storage_logEvent
+ *
+ * Description: Appends a record to the audit log ring in the external tier,
+ * 		the ring head is kept in the internal tier.
+ *
+ * Args:
+ *
+ * 		[in] Storage_AuditEventType a_event
+ * 			 uint8 a_arg
+ * 		[out] N/A
+ * Returns: uint8 (SUCCESS/ERROR)
+ *
+ *******************************************************************************/
+uint8 Storage_logEvent(Storage_AuditEventType a_event, uint8 a_arg);
+
+/******************************************************************************
+ *
+ * Function Name: Storage_saveClock
+ *
+ * Description: Queues a write of the boot record with a new saved clock
+ * 		(see rtc.h), restored by the next boot.
+ *
+ * Args:
+ *
+ * 		[in] uint16 a_minuteOfWeek
+ * 			RTC minute of the week.
+ * 		[out] N/A
+ * Returns: uint8 (SUCCESS/ERROR)
+ *
+ *******************************************************************************/
+uint8 Storage_saveClock(uint16 a_minuteOfWeek);
+
+/******************************************************************************
+ *
+ * Function Name: Storage_getBootRecord
+ *
+ * Description: Returns the boot record loaded by Storage_init.
+ * Args: void
+ * Returns: const Storage_BootRecordType*
+ *******************************************************************************/
+const Storage_BootRecordType* Storage_getBootRecord(void);
+
+/******************************************************************************
+ *
+ * Function Name: Storage_getTier / Storage_getTierInfo
+ *
+ * Description: Returns the tier a key is routed to / the latency and traffic
+ * 		figures of a tier.
+ *
+ *******************************************************************************/
+Storage_TierType Storage_getTier(Storage_KeyType a_key);
+void Storage_getTierInfo(Storage_TierType a_tier, Storage_TierInfoType *a_info);
+
+#endif /* STORAGE_H_ */
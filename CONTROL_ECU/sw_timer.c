@@ -0,0 +1,245 @@
+/******************************************************************************
+ *
+ * Module: Software Timer
+ *
+ * File Name: sw_timer.c
+ *
+ * Description: Source file for the software timer service.
+ *
+ * Date Created: 18/10/2026
+ *
+ * Author: Hazem Montasser
+ *
+ *******************************************************************************/
+
+#include "sw_timer.h"
+#include "systick.h"
+#include <util/atomic.h>
+
+/*******************************************************************************
+ *                         Global Variables(Private)                           *
+ *******************************************************************************/
+
+/* Running timers sorted by expiry (delta list) */
+static SwTimer_TimerType *volatile g_running_head = NULL_PTR;
+/* Expired timers waiting for SwTimer_dispatch (FIFO) */
+static SwTimer_TimerType *volatile g_ready_head = NULL_PTR;
+static SwTimer_TimerType *volatile g_ready_tail = NULL_PTR;
+static volatile uint16 g_ticks = 0; /* Ticks since SwTimer_init */
+/* One-shot timers lent out by SwTimer_after */
+static SwTimer_TimerType g_after_pool[SWTIMER_AFTER_POOL_SIZE];
+
+/*******************************************************************************
+ *                      Functions Definitions (Private)                        *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Links a timer into the running list at its expiry position, adjusting the
+ * delta of the node after it. Called with interrupts disabled.
+ */
+static void swTimer_insert(SwTimer_TimerType *a_timer, uint16 a_ticks) {
+	SwTimer_TimerType *volatile *link = &g_running_head;
+	/* Timers expiring at the same tick keep their start order */
+	while (*link != NULL_PTR && (*link)->Delta <= a_ticks) {
+		a_ticks -= (*link)->Delta;
+		link = &(*link)->Next;
+	}
+	a_timer->Delta = a_ticks;
+	a_timer->Next = *link;
+	if (*link != NULL_PTR) {
+		(*link)->Delta -= a_ticks;
+	}
+	*link = a_timer;
+	a_timer->State = SWTIMER_RUNNING;
+}
+
+/*
+ * Description :
+ * Unlinks a timer from whichever list it is in. Called with interrupts disabled.
+ */
+static void swTimer_remove(SwTimer_TimerType *a_timer) {
+	SwTimer_TimerType *volatile *link;
+	SwTimer_TimerType *prev = NULL_PTR;
+
+	if (a_timer->State == SWTIMER_RUNNING) {
+		link = &g_running_head;
+		while (*link != NULL_PTR && *link != a_timer) {
+			link = &(*link)->Next;
+		}
+		if (*link != NULL_PTR) {
+			/* Give the remaining delta to the next node */
+			if (a_timer->Next != NULL_PTR) {
+				a_timer->Next->Delta += a_timer->Delta;
+			}
+			*link = a_timer->Next;
+		}
+	} else if (a_timer->State == SWTIMER_EXPIRED) {
+		link = &g_ready_head;
+		while (*link != NULL_PTR && *link != a_timer) {
+			prev = *link;
+			link = &(*link)->Next;
+		}
+		if (*link != NULL_PTR) {
+			*link = a_timer->Next;
+			if (g_ready_tail == a_timer) {
+				g_ready_tail = prev;
+			}
+		}
+	}
+	a_timer->Next = NULL_PTR;
+	a_timer->State = SWTIMER_IDLE;
+}
+
+/*
+ * Description :
+ * Converts milliseconds to ticks, rounding up and saturating at 0xFFFF.
+ */
+static uint16 swTimer_msToTicks(uint32 a_ms) {
+	uint32 ticks = (a_ms + SWTIMER_TICK_MS - 1) / SWTIMER_TICK_MS;
+	return (ticks > 0xFFFF) ? 0xFFFF : (uint16) ticks;
+}
+
+/*******************************************************************************
+ *                              Functions Definitions                          *
+ *******************************************************************************/
+
+void SwTimer_init(void) {
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		g_running_head = NULL_PTR;
+		g_ready_head = NULL_PTR;
+		g_ready_tail = NULL_PTR;
+		g_ticks = 0;
+	}
+	for (uint8 i = 0; i < SWTIMER_AFTER_POOL_SIZE; i++) {
+		g_after_pool[i].State = SWTIMER_IDLE;
+	}
+}
+
+void SwTimer_start(SwTimer_TimerType *a_timer, uint16 a_ticks, uint16 a_period,
+		void (*a_ptrToCallback)(void)) {
+	if (a_ticks == 0) {
+		a_ticks = 1;
+	}
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		swTimer_remove(a_timer);
+		a_timer->Period = a_period;
+		a_timer->Callback = a_ptrToCallback;
+		swTimer_insert(a_timer, a_ticks);
+	}
+}
+
+void SwTimer_stop(SwTimer_TimerType *a_timer) {
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		swTimer_remove(a_timer);
+	}
+}
+
+boolean SwTimer_isRunning(const SwTimer_TimerType *a_timer) {
+	/* A periodic timer keeps running while waiting for dispatch */
+	return (a_timer->State == SWTIMER_RUNNING
+			|| (a_timer->State == SWTIMER_EXPIRED && a_timer->Period != 0)) ?
+			TRUE : FALSE;
+}
+
+boolean SwTimer_tick(void) {
+	SwTimer_TimerType *timer;
+	boolean expired = FALSE;
+	g_ticks++;
+	if (g_running_head == NULL_PTR) {
+		return FALSE;
+	}
+	g_running_head->Delta--;
+	/* Move every timer due at this tick to the ready list */
+	while (g_running_head != NULL_PTR && g_running_head->Delta == 0) {
+		timer = g_running_head;
+		g_running_head = timer->Next;
+		timer->Next = NULL_PTR;
+		timer->State = SWTIMER_EXPIRED;
+		if (g_ready_tail == NULL_PTR) {
+			g_ready_head = timer;
+		} else {
+			g_ready_tail->Next = timer;
+		}
+		g_ready_tail = timer;
+		expired = TRUE;
+	}
+	return expired;
+}
+
+void SwTimer_dispatch(void) {
+	SwTimer_TimerType *timer;
+	void (*callback)(void);
+
+	for (;;) {
+		ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+		{
+			timer = g_ready_head;
+			if (timer != NULL_PTR) {
+				g_ready_head = timer->Next;
+				if (g_ready_head == NULL_PTR) {
+					g_ready_tail = NULL_PTR;
+				}
+				timer->Next = NULL_PTR;
+				timer->State = SWTIMER_IDLE;
+				/* Reload before the callback so it may stop its own timer */
+				if (timer->Period != 0) {
+					swTimer_insert(timer, timer->Period);
+				}
+			}
+		}
+		if (timer == NULL_PTR) {
+			break;
+		}
+		callback = timer->Callback;
+		if (callback != NULL_PTR) {
+			callback();
+		}
+	}
+}
+
+SwTimer_TimerType* SwTimer_after(uint32 a_ms, void (*a_ptrToCallback)(void)) {
+	for (uint8 i = 0; i < SWTIMER_AFTER_POOL_SIZE; i++) {
+		/* A one-shot pool timer is free again once it is dispatched */
+		if (g_after_pool[i].State == SWTIMER_IDLE) {
+			SwTimer_start(&g_after_pool[i], swTimer_msToTicks(a_ms), 0,
+					a_ptrToCallback);
+			return &g_after_pool[i];
+		}
+	}
+	return NULL_PTR;
+}
+
+uint16 SwTimer_getTicks(void) {
+	uint16 ticks;
+	/* 16-bit read is not atomic on the AVR */
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		ticks = g_ticks;
+	}
+	return ticks;
+}
+
+uint16 SwTimer_getNextTicks(void) {
+	uint16 ticks = SWTIMER_NO_TIMER;
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		/* The head delta is the time to the first expiry */
+		if (g_running_head != NULL_PTR) {
+			ticks = g_running_head->Delta;
+		}
+	}
+	return ticks;
+}
+
+void SwTimer_deadlineSet(SwTimer_DeadlineType *a_deadline, uint32 a_ms) {
+	*a_deadline = SysTick_getMillis() + a_ms;
+}
+
+boolean SwTimer_deadlineExpired(const SwTimer_DeadlineType *a_deadline) {
+	/* Signed difference stays correct across the counter wrap-around */
+	return ((sint32) (SysTick_getMillis() - *a_deadline) >= 0) ? TRUE : FALSE;
+}
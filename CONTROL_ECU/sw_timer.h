@@ -0,0 +1,235 @@
+/******************************************************************************
+ *
+ * Module: Software Timer
+ *
+ * File Name: sw_timer.h
+ *
+ * Description: Header file for the software timer service which multiplexes
+ * 				the system tick into any number of one-shot and periodic
+ * 				virtual timers.
+ *
+ * 				Running timers are kept in a delta list sorted by expiry, each
+ * 				node holding the ticks left after the node before it, so
+ * 				SwTimer_tick only decrements the head: O(1) per tick however many
+ * 				timers are running. Starting a timer is O(n) in the running timers.
+ *
+ * 				Expired timers are moved to a ready list by SwTimer_tick (interrupt
+ * 				context) and their callbacks run from SwTimer_dispatch (main
+ * 				context), so callbacks may use the UART, TWI & storage drivers.
+ *
+ * Date Created: 18/10/2026
+ *
+ * Author: Hazem Montasser
+ *
+ *******************************************************************************/
+
+#ifndef SW_TIMER_H_
+#define SW_TIMER_H_
+
+#include "std_types.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define SWTIMER_TICK_MS 		(10U)	/* Period of SwTimer_tick calls, in system ticks (ms) */
+#define SWTIMER_AFTER_POOL_SIZE	(4U)	/* One-shot timers available to SwTimer_after */
+#define SWTIMER_NO_TIMER		(0xFFFFU)	/* SwTimer_getNextTicks: no timer running */
+
+/* Converts a time in ms/s to ticks (integer only, rounded up, min. 1 tick) */
+#define SWTIMER_MS_TO_TICKS(ms)	((uint16)(((ms) + SWTIMER_TICK_MS - 1) / SWTIMER_TICK_MS))
+#define SWTIMER_SEC_TO_TICKS(s)	((uint16)((s) * (1000U / SWTIMER_TICK_MS)))
+
+/*******************************************************************************
+ *                               Types Declaration                             *
+ *******************************************************************************/
+
+/* Timer states */
+typedef enum {
+	SWTIMER_IDLE, SWTIMER_RUNNING, SWTIMER_EXPIRED
+} SwTimer_StateType;
+
+/******************************************************************************
+ *
+ * Structure Name: SwTimer_TimerType
+ *
+ * Structure Description: One virtual timer. Allocated by the user (usually
+ * 		static) and linked into the service lists, fields are private.
+ *
+ *******************************************************************************/
+typedef struct SwTimer_Timer {
+	struct SwTimer_Timer *Next; /* Next node of the list the timer is in */
+	uint16 Delta; /* Ticks after the previous node (running list) */
+	uint16 Period; /* Reload in ticks, 0 for one-shot */
+	void (*Callback)(void); /* Called from SwTimer_dispatch on expiry */
+	volatile SwTimer_StateType State;
+} SwTimer_TimerType;
+
+/* Point in time for poll-style timeouts, in system tick milliseconds.
+ * Deadlines must be set less than 2^31 ms (~24.8 days) ahead */
+typedef uint32 SwTimer_DeadlineType;
+
+/*******************************************************************************
+ *                              Functions Prototypes                           *
+ *******************************************************************************/
+
+/******************************************************************************
+ *
+ * Function Name: SwTimer_init
+ *
+ * Description: Empties the running & ready lists.
+ * Args: void
+ * Returns: void
+ *******************************************************************************/
+void SwTimer_init(void);
+
+/******************************************************************************
+ *
+ * Function Name: SwTimer_start
+ *
+ * Description: (Re)starts a timer, a running timer is stopped first.
+ *
+ * Args:
+ *
+ * 		[in] SwTimer_TimerType *a_timer
+ * 			Timer to start.
+ * 			 uint16 a_ticks
+ * 			Ticks to the first expiry (0 is treated as 1).
+ * 			 uint16 a_period
+ * 			Ticks between later expiries, 0 for a one-shot timer.
+ * 			 void (*a_ptrToCallback)(void)
+ * 			Function called on every expiry, may be NULL_PTR (poll with
+ * 			SwTimer_isRunning instead).
+ * 		[out] N/A
+ * Returns: void
+ *
+ *******************************************************************************/
+void SwTimer_start(SwTimer_TimerType *a_timer, uint16 a_ticks, uint16 a_period,
+		void (*a_ptrToCallback)(void));
+
+/******************************************************************************
+ *
+ * Function Name: SwTimer_stop
+ *
+ * Description: Stops a timer, a pending expiry is discarded.
+ *
+ * Args:
+ *
+ * 		[in] SwTimer_TimerType *a_timer
+ * 			Timer to stop.
+ * 		[out] N/A
+ * Returns: void
+ *
+ *******************************************************************************/
+void SwTimer_stop(SwTimer_TimerType *a_timer);
+
+/******************************************************************************
+ *
+ * Function Name: SwTimer_isRunning
+ *
+ * Description: Returns TRUE until a one-shot timer expires or is stopped.
+ *
+ * Args:
+ *
+ * 		[in] const SwTimer_TimerType *a_timer
+ * 		[out] N/A
+ * Returns: boolean
+ *
+ *******************************************************************************/
+boolean SwTimer_isRunning(const SwTimer_TimerType *a_timer);
+
+/******************************************************************************
+ *
+ * Function Name: SwTimer_tick
+ *
+ * Description: Advances the service by one tick, moving expired timers to the
+ * 		ready list. Called every SWTIMER_TICK_MS system ticks.
+ * Args: void
+ * Returns: boolean (TRUE if a timer expired, SwTimer_dispatch has work)
+ *******************************************************************************/
+boolean SwTimer_tick(void);
+
+/******************************************************************************
+ *
+ * Function Name: SwTimer_dispatch
+ *
+ * Description: Reloads expired periodic timers and runs the callbacks of all
+ * 		expired timers. Meant to be called from the main loop.
+ * Args: void
+ * Returns: void
+ *******************************************************************************/
+void SwTimer_dispatch(void);
+
+/******************************************************************************
+ *
+ * Function Name: SwTimer_after
+ *
+ * Description: Calls a function once after a delay, using a timer taken from
+ * 		an internal pool and returned to it on expiry.
+ *
+ * Args:
+ *
+ * 		[in] uint32 a_ms
+ * 			Delay in milliseconds, rounded up to whole ticks.
+ * 			 void (*a_ptrToCallback)(void)
+ * 			Function called from SwTimer_dispatch.
+ * 		[out] N/A
+ * Returns: SwTimer_TimerType* (Pool timer, to cancel with SwTimer_stop,
+ * 		or NULL_PTR if the pool is exhausted)
+ *
+ *******************************************************************************/
+SwTimer_TimerType* SwTimer_after(uint32 a_ms, void (*a_ptrToCallback)(void));
+
+/******************************************************************************
+ *
+ * Function Name: SwTimer_getTicks
+ *
+ * Description: Returns the number of ticks since SwTimer_init (wraps around).
+ * Args: void
+ * Returns: uint16
+ *******************************************************************************/
+uint16 SwTimer_getTicks(void);
+
+/******************************************************************************
+ *
+ * Function Name: SwTimer_getNextTicks
+ *
+ * Description: Returns the ticks until the next running timer expires, for
+ * 		tickless idle. SWTIMER_NO_TIMER if no timer is running.
+ * Args: void
+ * Returns: uint16
+ *******************************************************************************/
+uint16 SwTimer_getNextTicks(void);
+
+/******************************************************************************
+ *
+ * Function Name: SwTimer_deadlineSet
+ *
+ * Description: Sets a deadline a_ms from now on the system tick clock.
+ *
+ * Args:
+ *
+ * 		[in] uint32 a_ms
+ * 			Time from now in milliseconds.
+ * 		[out] SwTimer_DeadlineType *a_deadline
+ * Returns: void
+ *
+ *******************************************************************************/
+void SwTimer_deadlineSet(SwTimer_DeadlineType *a_deadline, uint32 a_ms);
+
+/******************************************************************************
+ *
+ * Function Name: SwTimer_deadlineExpired
+ *
+ * Description: Returns TRUE once the deadline has been reached.
+ *
+ * Args:
+ *
+ * 		[in] const SwTimer_DeadlineType *a_deadline
+ * 		[out] N/A
+ * Returns: boolean
+ *
+ *******************************************************************************/
+boolean SwTimer_deadlineExpired(const SwTimer_DeadlineType *a_deadline);
+
+#endif /* SW_TIMER_H_ */
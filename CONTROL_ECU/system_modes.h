@@ -28,6 +28,10 @@
 /* Control requests */
 #define OPEN_DOOR_REQUEST 		(0x04) /* Sent by HMI to notify Control to open the door*/
 #define CHANGE_PASS_REQUEST 	(0x05) /* Sent by HMI to notify Control to change password*/
+#define CONFIG_SET_REQUEST 		(0x06) /* After a correct password: key, value LSB, value MSB, changes a configuration value*/
+#define PROFILE_DUMP_REQUEST 	(0x07) /* Debug: answered with SYNC and the length-prefixed profiler table if PROFILER_ENABLE (see profiler.h)*/
+#define RTC_SET_REQUEST 		(0x08) /* After a correct password: weekday, hour, minute, second, sets the clock*/
+#define ACCESS_SET_REQUEST 		(0x09) /* After a correct password: user, weekday, hours mask (3 bytes, LSB first), sets an access window*/
 
 #define ERROR 					(0x00)
 #define SUCCESS					(0x01)
@@ -0,0 +1,206 @@
+/******************************************************************************
+ *
+ * Module: System Tick
+ *
+ * File Name: systick.c
+ *
+ * Description: Source file for the 1ms monotonic system tick and uptime clock.
+ *
+ * Date Created: 18/10/2026
+ *
+ * Author: Hazem Montasser
+ *
+ *******************************************************************************/
+
+#include "systick.h"
+#include "timer.h"
+#include "common_macros.h"
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+#include <util/atomic.h>
+
+/* Build fails here if F_CPU can't give a 1ms tick on Timer2 */
+TIMER_PERIOD_ASSERT(TIMER2_ID, SYSTICK_PERIOD_US, systick);
+
+/*******************************************************************************
+ *                         Global Variables(Private)                           *
+ *******************************************************************************/
+
+static volatile uint32 g_millis = 0; /* Milliseconds since SysTick_init */
+static volatile uint16 g_millis_wraps = 0; /* Times g_millis wrapped around */
+static void (*volatile g_SysTick_callbackNotif)(void) = NULL_PTR;
+static volatile boolean g_sleeping = FALSE; /* Timer2 is in the long sleep setup */
+static volatile boolean g_sleep_matched = FALSE; /* Wake-up time reached while sleeping */
+static SysTick_IdleStatsType g_idle_stats;
+
+/*******************************************************************************
+ *                      Functions Definitions (Private)                        *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Timer2 compare match callback, one call per millisecond.
+ */
+static void sysTick_tick(void) {
+	/* Long sleep compare match: only wake up, SysTick_sleepFor updates the clock */
+	if (g_sleeping) {
+		g_sleep_matched = TRUE;
+		return;
+	}
+	if (++g_millis == 0) {
+		g_millis_wraps++;
+	}
+	if (g_SysTick_callbackNotif != NULL_PTR) {
+		(*g_SysTick_callbackNotif)();
+	}
+}
+
+/*******************************************************************************
+ *                              Functions Definitions                          *
+ *******************************************************************************/
+
+void SysTick_init(void) {
+	/*
+	 * Timer init:
+	 * 	Timer used = Timer2
+	 * 	Pre-scaler clock & compare value = solved for 1ms (F_CPU/32, 249 at 8MHz)
+	 * 	Mode = Compare mode (CTC)
+	 * 	Interrupt on compare match = TRUE for enabled
+	 * */
+	Timer_ConfigType TIMER_CONFIG = TIMER_CONFIG_PERIOD(TIMER2_ID,
+			SYSTICK_PERIOD_US, TRUE);
+
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		g_millis = 0;
+		g_millis_wraps = 0;
+	}
+	Timer_setSourceCallback(TIMER2_COMP_SOURCE, sysTick_tick);
+	Timer_init(&TIMER_CONFIG);
+}
+
+void SysTick_setCallback(void (*a_ptrToCallback)(void)) {
+	g_SysTick_callbackNotif = a_ptrToCallback;
+}
+
+uint32 SysTick_getMillis(void) {
+	uint32 millis;
+	/* 32-bit read takes 4 instructions, the ISR must not update it midway */
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		millis = g_millis;
+	}
+	return millis;
+}
+
+uint32 SysTick_getMicros(void) {
+	uint32 millis;
+	uint8 count;
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		millis = g_millis;
+		count = TCNT2;
+		/* Counter cleared but the ISR has not run yet: count the pending ms */
+		if (BIT_IS_SET(TIFR, OCF2) && count < SYSTICK_COMPARE_VALUE) {
+			millis++;
+		}
+	}
+	return millis * 1000UL + count * SYSTICK_US_PER_COUNT;
+}
+
+uint64 SysTick_getUptime(void) {
+	uint32 millis;
+	uint16 wraps;
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		millis = g_millis;
+		wraps = g_millis_wraps;
+	}
+	return ((uint64) wraps << 32) | millis;
+}
+
+void SysTick_sleepFor(uint32 a_ms) {
+	Timer_ConfigType TICK_CONFIG = TIMER_CONFIG_PERIOD(TIMER2_ID,
+			SYSTICK_PERIOD_US, TRUE);
+	Timer_ConfigType SLEEP_CONFIG = { TIMER2_ID, FCPU_1024_T2,
+			Timer_Mode_Compare, 0, TRUE };
+	uint16 counts;
+	uint32 elapsed_us;
+	uint32 millis = g_millis;
+
+	set_sleep_mode(SLEEP_MODE_IDLE);
+	/* Short waits, or a tick already pending: the next tick wakes the CPU */
+	if (a_ms < SYSTICK_SLEEP_MIN_MS || BIT_IS_SET(TIFR, OCF2)) {
+		sleep_enable();
+		sei();
+		sleep_cpu();
+		sleep_disable();
+		return;
+	}
+	if (a_ms > SYSTICK_SLEEP_MAX_MS) {
+		a_ms = SYSTICK_SLEEP_MAX_MS;
+	}
+	counts = (a_ms * 1000UL) / SYSTICK_SLEEP_US_PER_COUNT;
+	/* Part of the current millisecond already elapsed */
+	elapsed_us = TCNT2 * SYSTICK_US_PER_COUNT;
+
+	/* One compare match at the wake-up time */
+	SLEEP_CONFIG.Compare_Value = counts - 1;
+	g_sleeping = TRUE;
+	g_sleep_matched = FALSE;
+	Timer_init(&SLEEP_CONFIG);
+	TIFR = (1 << OCF2);
+
+	/* sei takes effect after the next instruction, no wake-up is lost */
+	sleep_enable();
+	sei();
+	sleep_cpu();
+	sleep_disable();
+	cli();
+
+	/* Freeze Timer2 and count the time slept */
+	Timer_stop(TIMER2_ID);
+	if (BIT_IS_SET(TIFR, OCF2)) {
+		g_sleep_matched = TRUE;
+		TIFR = (1 << OCF2);
+		elapsed_us += (uint32) counts * SYSTICK_SLEEP_US_PER_COUNT;
+	} else if (g_sleep_matched) {
+		elapsed_us += (uint32) counts * SYSTICK_SLEEP_US_PER_COUNT;
+	}
+	elapsed_us += TCNT2 * SYSTICK_SLEEP_US_PER_COUNT;
+	g_sleeping = FALSE;
+
+	g_idle_stats.Sleeps++;
+	if (g_sleep_matched) {
+		/* Counts since the match = wake-up latency */
+		g_idle_stats.TimerWakes++;
+		g_idle_stats.LastWakeLatency_us = TCNT2 * SYSTICK_SLEEP_US_PER_COUNT;
+		if (g_idle_stats.LastWakeLatency_us > g_idle_stats.MaxWakeLatency_us) {
+			g_idle_stats.MaxWakeLatency_us = g_idle_stats.LastWakeLatency_us;
+		}
+	}
+
+	/* Whole milliseconds go to the clock, the rest back into TCNT2 */
+	while (elapsed_us >= 1000UL) {
+		elapsed_us -= 1000UL;
+		g_idle_stats.Slept_ms++;
+		if (++g_millis == 0) {
+			g_millis_wraps++;
+		}
+	}
+	Timer_init(&TICK_CONFIG);
+	TCNT2 = elapsed_us / SYSTICK_US_PER_COUNT;
+
+	if (g_millis != millis && g_SysTick_callbackNotif != NULL_PTR) {
+		(*g_SysTick_callbackNotif)();
+	}
+	sei();
+}
+
+void SysTick_getIdleStats(SysTick_IdleStatsType *a_stats) {
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		*a_stats = g_idle_stats;
+	}
+}
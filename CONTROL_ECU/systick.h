@@ -0,0 +1,157 @@
+/******************************************************************************
+ *
+ * Module: System Tick
+ *
+ * File Name: systick.h
+ *
+ * Description: Header file for the 1ms monotonic system tick and uptime clock.
+ *
+ * 				Timer2 runs in CTC mode and interrupts every 1ms, the pre-scaler
+ * 				and OCR2 are solved at compile time from F_CPU (see timer.h):
+ * 					F_CPU/32, OCR2 = 249 at 8MHz
+ *
+ * 				SysTick_sleepFor implements tickless idle: Timer2 is switched to
+ * 				F_CPU/1024 with one compare match at the wake-up time (up to
+ * 				SYSTICK_SLEEP_MAX_MS), the clock is advanced by the time slept
+ * 				on wake-up from any interrupt.
+ *
+ * 				The millisecond counter is 32-bit (wraps after ~49.7 days), a
+ * 				16-bit wrap counter extends it to the 64-bit uptime.
+ *
+ * Date Created: 18/10/2026
+ *
+ * Author: Hazem Montasser
+ *
+ *******************************************************************************/
+
+#ifndef SYSTICK_H_
+#define SYSTICK_H_
+
+#include "std_types.h"
+#include "timer.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define SYSTICK_PERIOD_US		(1000UL)
+#define SYSTICK_COMPARE_VALUE	TIMER_PERIOD_COMPARE(TIMER2_ID, SYSTICK_PERIOD_US)
+#define SYSTICK_US_PER_COUNT	((uint32) TIMER_PERIOD_US_PER_COUNT(TIMER2_ID, SYSTICK_PERIOD_US))	/* TCNT2 resolution */
+
+/* Tickless idle: Timer2 at F_CPU/1024 while sleeping (128us per count at 8MHz) */
+#define SYSTICK_SLEEP_US_PER_COUNT	(1024UL * 1000000UL / F_CPU)
+#define SYSTICK_SLEEP_MAX_MS	(256UL * SYSTICK_SLEEP_US_PER_COUNT / 1000UL)	/* Longest sleep in one stretch */
+#define SYSTICK_SLEEP_MIN_MS	(2UL)	/* Shorter waits sleep until the next tick */
+
+/*******************************************************************************
+ *                               Types Declaration                             *
+ *******************************************************************************/
+
+/******************************************************************************
+ *
+ * Structure Name: SysTick_IdleStatsType
+ *
+ * Structure Description: Tickless idle accounting, active CPU time is
+ * 		uptime - Slept_ms.
+ *
+ *******************************************************************************/
+typedef struct {
+	uint32 Sleeps; /* Long sleeps (Timer2 reprogrammed) */
+	uint32 TimerWakes; /* Long sleeps that ran to the wake-up time */
+	uint32 Slept_ms; /* Total time spent in long sleeps */
+	uint16 LastWakeLatency_us; /* Wake-up time to clock restored, last timer wake */
+	uint16 MaxWakeLatency_us; /* Worst of the above */
+} SysTick_IdleStatsType;
+
+/*******************************************************************************
+ *                              Functions Prototypes                           *
+ *******************************************************************************/
+
+/******************************************************************************
+ *
+ * Function Name: SysTick_init
+ *
+ * Description: Clears the clock and starts Timer2 through Timer_init.
+ * 		---Note: Timer2 and its callback are reserved for the system tick.
+ * Args: void
+ * Returns: void
+ *******************************************************************************/
+void SysTick_init(void);
+
+/******************************************************************************
+ *
+ * Function Name: SysTick_setCallback
+ *
+ * Description: Sets a function called (in interrupt context) on every tick,
+ * 		after the clock is updated. After a tickless sleep it is called once
+ * 		with the clock advanced by the whole time slept.
+ * Args:
+ * 		[in] void (*a_ptrToCallback)(void)
+ * 			Pointer to the callback function.
+ * 		[out] N/A
+ * Returns: void
+ *******************************************************************************/
+void SysTick_setCallback(void (*a_ptrToCallback)(void));
+
+/******************************************************************************
+ *
+ * Function Name: SysTick_getMillis
+ *
+ * Description: Returns the milliseconds since SysTick_init, read atomically.
+ * Args: void
+ * Returns: uint32
+ *******************************************************************************/
+uint32 SysTick_getMillis(void);
+
+/******************************************************************************
+ *
+ * Function Name: SysTick_getMicros
+ *
+ * Description: Returns the microseconds since SysTick_init (wraps after ~71
+ * 		minutes) with the resolution of one Timer2 count, for measuring
+ * 		short durations.
+ * Args: void
+ * Returns: uint32
+ *******************************************************************************/
+uint32 SysTick_getMicros(void);
+
+/******************************************************************************
+ *
+ * Function Name: SysTick_getUptime
+ *
+ * Description: Returns the milliseconds since SysTick_init without wrap-around.
+ * Args: void
+ * Returns: uint64
+ *******************************************************************************/
+uint64 SysTick_getUptime(void);
+
+/******************************************************************************
+ *
+ * Function Name: SysTick_sleepFor
+ *
+ * Description: Sleeps in SLEEP_MODE_IDLE until an interrupt or until a_ms
+ * 		elapses (capped to SYSTICK_SLEEP_MAX_MS), keeping the clock exact to
+ * 		one Timer2 count. The ticks in between are suppressed.
+ * 		---Note: Call with interrupts disabled after checking there is no
+ * 		work left, returns with interrupts enabled.
+ * Args:
+ * 		[in] uint32 a_ms
+ * 			Time to the next deadline.
+ * 		[out] N/A
+ * Returns: void
+ *******************************************************************************/
+void SysTick_sleepFor(uint32 a_ms);
+
+/******************************************************************************
+ *
+ * Function Name: SysTick_getIdleStats
+ *
+ * Description: Copies the tickless idle accounting into a_stats.
+ * Args:
+ * 		[in] N/A
+ * 		[out] SysTick_IdleStatsType *a_stats
+ * Returns: void
+ *******************************************************************************/
+void SysTick_getIdleStats(SysTick_IdleStatsType *a_stats);
+
+#endif /* SYSTICK_H_ */
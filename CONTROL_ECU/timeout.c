@@ -0,0 +1,57 @@
+/******************************************************************************
+ *
+ * Module: Timeout
+ *
+ * File Name: timeout.c
+ *
+ * Description: Source file for the deadline/timeout facility of the blocking
+ * 				driver calls.
+ *
+ * Date Created: 18/10/2026
+ *
+ * Author: Hazem Montasser
+ *
+ *******************************************************************************/
+
+#include "timeout.h"
+#include "systick.h"
+
+/*******************************************************************************
+ *                         Global Variables(Private)                           *
+ *******************************************************************************/
+
+/* Timeouts per call site, only updated from the waiting (non-interrupt) code */
+static uint16 g_Timeout_counts[TIMEOUT_SITES_COUNT];
+
+/*******************************************************************************
+ *                              Functions Definitions                          *
+ *******************************************************************************/
+
+void Timeout_start(Timeout_DeadlineType *a_deadline, uint32 a_ms) {
+	*a_deadline = SysTick_getMillis() + a_ms;
+}
+
+Timeout_StatusType Timeout_check(const Timeout_DeadlineType *a_deadline,
+		Timeout_SiteType a_site) {
+	if (a_deadline == TIMEOUT_FOREVER) {
+		return TIMEOUT_STATUS_OK;
+	}
+	/* Signed difference stays correct across the 32-bit clock wrap */
+	if ((sint32) (SysTick_getMillis() - *a_deadline) < 0) {
+		return TIMEOUT_STATUS_OK;
+	}
+	if (a_site < TIMEOUT_SITES_COUNT && g_Timeout_counts[a_site] != 0xFFFF) {
+		g_Timeout_counts[a_site]++;
+	}
+	return TIMEOUT_STATUS_EXPIRED;
+}
+
+uint16 Timeout_getCount(Timeout_SiteType a_site) {
+	return (a_site < TIMEOUT_SITES_COUNT) ? g_Timeout_counts[a_site] : 0;
+}
+
+void Timeout_clearCounts(void) {
+	for (uint8 i = 0; i < TIMEOUT_SITES_COUNT; i++) {
+		g_Timeout_counts[i] = 0;
+	}
+}
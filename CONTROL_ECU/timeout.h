@@ -0,0 +1,119 @@
+/******************************************************************************
+ *
+ * Module: Timeout
+ *
+ * File Name: timeout.h
+ *
+ * Description: Header file for the deadline/timeout facility of the blocking
+ * 				driver calls.
+ *
+ * 				A deadline is a point in time on the system tick clock. Blocking
+ * 				driver calls take an optional deadline (TIMEOUT_FOREVER = no
+ * 				bound) and give up with TIMEOUT_STATUS_EXPIRED once it passes.
+ * 				Every expiry is counted per call site, so the worst-case wait of
+ * 				any path is the sum of its deadlines.
+ *
+ * 				---Note: The clock only advances with SysTick_init called and
+ * 				interrupts enabled, a deadline never expires otherwise.
+ *
+ * Date Created: 18/10/2026
+ *
+ * Author: Hazem Montasser
+ *
+ *******************************************************************************/
+
+#ifndef TIMEOUT_H_
+#define TIMEOUT_H_
+
+#include "std_types.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define TIMEOUT_FOREVER 		(NULL_PTR)	/* Deadline argument: wait without bound */
+
+/*******************************************************************************
+ *                               Types Declaration                             *
+ *******************************************************************************/
+
+/* Result of every call taking a deadline */
+typedef enum {
+	TIMEOUT_STATUS_OK, TIMEOUT_STATUS_EXPIRED
+} Timeout_StatusType;
+
+/* Call sites with a timeout counter */
+typedef enum {
+	TIMEOUT_SITE_UART_TX,
+	TIMEOUT_SITE_UART_RX,
+	TIMEOUT_SITE_TWI_START,
+	TIMEOUT_SITE_TWI_STOP,
+	TIMEOUT_SITE_TWI_WRITE,
+	TIMEOUT_SITE_TWI_READ,
+	TIMEOUT_SITE_EEPROM_READY,
+	TIMEOUT_SITE_KEYPAD,
+	TIMEOUT_SITES_COUNT
+} Timeout_SiteType;
+
+/* Point in time on the system tick clock (ms). Deadlines must be set less
+ * than 2^31 ms (~24.8 days) ahead */
+typedef uint32 Timeout_DeadlineType;
+
+/*******************************************************************************
+ *                              Functions Prototypes                           *
+ *******************************************************************************/
+
+/******************************************************************************
+ *
+ * Function Name: Timeout_start
+ *
+ * Description: Sets a deadline a_ms from now.
+ * Args:
+ * 		[in] uint32 a_ms
+ * 			Time allowed, in milliseconds.
+ * 		[out] Timeout_DeadlineType *a_deadline
+ * Returns: void
+ *******************************************************************************/
+void Timeout_start(Timeout_DeadlineType *a_deadline, uint32 a_ms);
+
+/******************************************************************************
+ *
+ * Function Name: Timeout_check
+ *
+ * Description: Polled inside a wait loop: returns TIMEOUT_STATUS_EXPIRED and
+ * 		counts a timeout of a_site once the deadline has passed.
+ * Args:
+ * 		[in] const Timeout_DeadlineType *a_deadline
+ * 			Deadline, TIMEOUT_FOREVER never expires.
+ * 			 Timeout_SiteType a_site
+ * 			Call site to count the timeout against.
+ * 		[out] N/A
+ * Returns: Timeout_StatusType
+ *******************************************************************************/
+Timeout_StatusType Timeout_check(const Timeout_DeadlineType *a_deadline,
+		Timeout_SiteType a_site);
+
+/******************************************************************************
+ *
+ * Function Name: Timeout_getCount
+ *
+ * Description: Returns how many times a call site timed out (saturates at
+ * 		0xFFFF).
+ * Args:
+ * 		[in] Timeout_SiteType a_site
+ * 		[out] N/A
+ * Returns: uint16
+ *******************************************************************************/
+uint16 Timeout_getCount(Timeout_SiteType a_site);
+
+/******************************************************************************
+ *
+ * Function Name: Timeout_clearCounts
+ *
+ * Description: Clears the timeout counters of all call sites.
+ * Args: void
+ * Returns: void
+ *******************************************************************************/
+void Timeout_clearCounts(void);
+
+#endif /* TIMEOUT_H_ */
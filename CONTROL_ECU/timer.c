@@ -13,6 +13,7 @@
  *******************************************************************************/
 
 #include "timer.h"
+#include "profiler.h"
 #include <avr/io.h>
 #include <avr/interrupt.h>
 
@@ -20,54 +21,86 @@
  *                         Global Variables(Private)                           *
  *******************************************************************************/
 
-/**** Callback pointer to function variables used in ISR's****/
-volatile static void (*g_Timer0_callbackNotif)(void) = NULL_PTR;
-volatile static void (*g_Timer1_callbackNotif)(void) = NULL_PTR;
-volatile static void (*g_Timer2_callbackNotif)(void) = NULL_PTR;
+/**** Callback pointer to function variables used in ISR's, one per Timer_Source****/
+static void (*volatile g_Timer_callbacks[TIMER_SOURCES_COUNT])(void);
+
+/**** TIMSK enable bit of each Timer_Source****/
+static const uint8 g_Timer_sourceMasks[TIMER_SOURCES_COUNT] = { (1 << TOIE0),
+		(1 << OCIE0), (1 << TOIE1), (1 << OCIE1A), (1 << OCIE1B), (1 << TICIE1),
+		(1 << TOIE2), (1 << OCIE2) };
 
 /**** Saves the current clock pre-scaler to be used in Timer_resume function****/
 volatile static Timer01_Clock Timer0_Current_Clock = 0;
 volatile static Timer01_Clock Timer1_Current_Clock = 0;
 volatile static Timer2_Clock Timer2_Current_Clock = 0;
 
+/*******************************************************************************
+ *                      Functions Definitions (Private)                        *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Calls the callback of an interrupt source if one is set.
+ */
+static inline void timer_notify(Timer_Source a_source) {
+	if (g_Timer_callbacks[a_source] != NULL_PTR) {
+		(*g_Timer_callbacks[a_source])();
+	}
+}
+
+/*
+ * Description :
+ * Returns the WGM bits of Timers 0 & 2 (same bit positions in TCCR0 & TCCR2),
+ * with the FOC bit for the non-PWM modes.
+ * 	Normal: WGM1:0 = 00, CTC: 10, Fast PWM: 11, Phase correct PWM: 01
+ */
+static uint8 timer_wgm8Bits(Timer_Mode a_mode) {
+	switch (a_mode) {
+	case Timer_Mode_Compare:
+		return (1 << FOC0) | (1 << WGM01);
+	case Timer_Mode_FastPWM:
+		return (1 << WGM00) | (1 << WGM01);
+	case Timer_Mode_PhaseCorrectPWM:
+		return (1 << WGM00);
+	default:
+		return (1 << FOC0);
+	}
+}
+
 /*******************************************************************************
  *                              ISR's Definitions                              *
  *******************************************************************************/
 
 /**********Timer 0 ISR's**********/
 ISR(TIMER0_COMP_vect) {
-	if (g_Timer0_callbackNotif != NULL_PTR) {
-		(*g_Timer0_callbackNotif)();
-	}
+	timer_notify(TIMER0_COMP_SOURCE);
 }
 ISR(TIMER0_OVF_vect) {
-	if (g_Timer0_callbackNotif != NULL_PTR) {
-		(*g_Timer0_callbackNotif)();
-	}
+	timer_notify(TIMER0_OVF_SOURCE);
 }
 
 /**********Timer 1 ISR's**********/
 ISR(TIMER1_OVF_vect) {
-	if (g_Timer1_callbackNotif != NULL_PTR) {
-		(*g_Timer1_callbackNotif)();
-	}
+	timer_notify(TIMER1_OVF_SOURCE);
 }
 ISR(TIMER1_COMPA_vect) {
-	if (g_Timer1_callbackNotif != NULL_PTR) {
-		(*g_Timer1_callbackNotif)();
-	}
+	timer_notify(TIMER1_COMPA_SOURCE);
+}
+ISR(TIMER1_COMPB_vect) {
+	timer_notify(TIMER1_COMPB_SOURCE);
+}
+ISR(TIMER1_CAPT_vect) {
+	timer_notify(TIMER1_CAPT_SOURCE);
 }
 
 /**********Timer 2 ISR's**********/
 ISR(TIMER2_OVF_vect) {
-	if (g_Timer2_callbackNotif != NULL_PTR) {
-		(*g_Timer2_callbackNotif)();
-	}
+	timer_notify(TIMER2_OVF_SOURCE);
 }
 ISR(TIMER2_COMP_vect) {
-	if (g_Timer2_callbackNotif != NULL_PTR) {
-		(*g_Timer2_callbackNotif)();
-	}
+	PROFILE_BEGIN(PROBE_ISR_TIMER2_COMP);
+	timer_notify(TIMER2_COMP_SOURCE);
+	PROFILE_END(PROBE_ISR_TIMER2_COMP);
 }
 
 /*******************************************************************************
@@ -86,20 +119,24 @@ void Timer_init(const Timer_ConfigType *Config) {
 
 		/**************** Configuring Mode, Interrupts & Pre-scaler ****************/
 
+		/* Load compare value (duty cycle in PWM modes) into OCR0 register*/
+		OCR0 = Config->Compare_Value;
 		if (Config->Mode == Timer_Mode_Compare) {
-			/* Load compare value into OCR0 register*/
-			OCR0 = Config->Compare_Value;
-
 			/* Enable/Disable interrupt for compare mode*/
 			TIMSK |= (Config->Interrupt_Enable << OCIE0);
 
-		} else if (Config->Mode == Timer_Mode_Normal) {
+		} else {
 
-			/* Enable/Disable interrupt for overflow mode*/
+			/* Enable/Disable interrupt for overflow & PWM modes*/
 			TIMSK |= (Config->Interrupt_Enable << TOIE0);
 		}
 		Timer0_Current_Clock = Config->Prescaler;
-		TCCR0 = (1 << FOC0) | (Config->Mode << WGM01)
+		/* -WGM01:00 & FOC0 according to mode
+		 * -COM01:00 = OC0 pin behavior
+		 * -Insert pre-scaler bits CS0 2:0 in the first 3 bits
+		 * */
+		TCCR0 = timer_wgm8Bits(Config->Mode)
+				| ((Config->Output & 0x03) << COM00)
 				| (Config->Prescaler & 0x07);
 
 		break;
@@ -110,32 +147,47 @@ void Timer_init(const Timer_ConfigType *Config) {
 		/**************** Clearing timer/counter register ****************/
 		TCNT1 = 0;
 
-		/**************** Configuring FOC bits ****************/
-
-		/*
-		 * -FOC1A,B = 1 -> Needed for any non-PWM mode.
-		 * */
-		TCCR1A = (1 << FOC1A) | (1 << FOC1B);
-
 		/**************** Configuring Mode, Interrupts & Pre-scaler ****************/
 
+		/* Load compare values (duty cycles in PWM modes) into OCR1A/B registers*/
+		OCR1A = Config->Compare_Value;
+		OCR1B = Config->Compare_B_Value;
 		if (Config->Mode == Timer_Mode_Compare) {
-			/* Load compare value into OCR0 register*/
-			OCR1A = Config->Compare_Value;
-
 			/* Enable/Disable interrupt for compare mode*/
 			TIMSK |= (Config->Interrupt_Enable << OCIE1A);
-		} else if (Config->Mode == Timer_Mode_Normal) {
-			/* Enable/Disable interrupt for overflow mode*/
+		} else {
+			/* Enable/Disable interrupt for overflow & PWM modes*/
 			TIMSK |= (Config->Interrupt_Enable << TOIE1);
 		}
 		Timer1_Current_Clock = Config->Prescaler;
-		/* -WGM12 = Mode-> To set mode to either normal/CTC
-		 * 	For normal mode: WGM1 2:0 = 000
-		 * 	For CTC    mode: WGM1 2:0 = 100
+		/*
+		 * -COM1A/B 1:0 = OC1A/OC1B pin behavior
+		 * -WGM1 3:0:
+		 * 	For normal mode: 0000, FOC1A,B = 1 (needed for any non-PWM mode)
+		 * 	For CTC    mode: 0100, FOC1A,B = 1
+		 * 	For fast PWM 10-bit mode: 0111
+		 * 	For phase correct PWM 10-bit mode: 0011
 		 * -Insert pre-scaler bits CS1 2:0 in the first 3 bits
 		 * */
-		TCCR1B = (Config->Mode << WGM12) | (Config->Prescaler & 0x07);
+		TCCR1A = ((Config->Output & 0x03) << COM1A0)
+				| ((Config->Output_B & 0x03) << COM1B0);
+		TCCR1B = (Config->Prescaler & 0x07);
+		switch (Config->Mode) {
+		case Timer_Mode_Compare:
+			TCCR1A |= (1 << FOC1A) | (1 << FOC1B);
+			TCCR1B |= (1 << WGM12);
+			break;
+		case Timer_Mode_FastPWM:
+			TCCR1A |= (1 << WGM11) | (1 << WGM10);
+			TCCR1B |= (1 << WGM12);
+			break;
+		case Timer_Mode_PhaseCorrectPWM:
+			TCCR1A |= (1 << WGM11) | (1 << WGM10);
+			break;
+		default:
+			TCCR1A |= (1 << FOC1A) | (1 << FOC1B);
+			break;
+		}
 		break;
 		/********************************* Timer 2 Setup *********************************/
 	case TIMER2_ID:
@@ -146,26 +198,24 @@ void Timer_init(const Timer_ConfigType *Config) {
 
 		/**************** Configuring Mode, Interrupts & Pre-scaler ****************/
 
+		/* Load compare value (duty cycle in PWM modes) into OCR2 register*/
+		OCR2 = Config->Compare_Value;
 		if (Config->Mode == Timer_Mode_Compare) {
-			/* Load compare value into OCR0 register*/
-			OCR2 = Config->Compare_Value;
-
 			/* Enable/Disable interrupt for compare mode*/
 			TIMSK |= (Config->Interrupt_Enable << OCIE2);
 
-		} else if (Config->Mode == Timer_Mode_Normal) {
+		} else {
 
-			/* Enable/Disable interrupt for overflow mode*/
+			/* Enable/Disable interrupt for overflow & PWM modes*/
 			TIMSK |= (Config->Interrupt_Enable << TOIE2);
 		}
 		Timer2_Current_Clock = Config->Prescaler;
-		/* -FOC2 = 0  -> Needed for any non-PWM mode
+		/* -WGM21:20 & FOC2 according to mode (same positions as Timer0)
+		 * -COM21:20 = OC2 pin behavior
 		 * -Insert pre-scaler bits CS2 2:0 in the first 3 bits
-		 * -WGM21 = Mode-> To set mode to either normal/CTC
-		 * 	For normal mode: WGM2 1:0 = 00
-		 * 	For CTC    mode: WGM2 1:0 = 10
 		 * */
-		TCCR2 = (1 << FOC2) | (Config->Mode << WGM21)
+		TCCR2 = timer_wgm8Bits(Config->Mode)
+				| ((Config->Output & 0x03) << COM20)
 				| ((Config->Prescaler) & 0x07);
 
 		break;
@@ -174,20 +224,41 @@ void Timer_init(const Timer_ConfigType *Config) {
 
 }
 void Timer_setCallback(uint8 a_Timer_ID, void (*a_ptrToCallback)(void)) {
-	/* Set the callback function of a timer according to timer ID*/
+	/* Set the overflow & compare callbacks of a timer according to timer ID*/
 	switch (a_Timer_ID) {
 	case TIMER0_ID:
-		g_Timer0_callbackNotif = a_ptrToCallback;
+		Timer_setSourceCallback(TIMER0_OVF_SOURCE, a_ptrToCallback);
+		Timer_setSourceCallback(TIMER0_COMP_SOURCE, a_ptrToCallback);
 		break;
 	case TIMER1_ID:
-		g_Timer1_callbackNotif = a_ptrToCallback;
+		Timer_setSourceCallback(TIMER1_OVF_SOURCE, a_ptrToCallback);
+		Timer_setSourceCallback(TIMER1_COMPA_SOURCE, a_ptrToCallback);
 		break;
 	case TIMER2_ID:
-		g_Timer2_callbackNotif = a_ptrToCallback;
+		Timer_setSourceCallback(TIMER2_OVF_SOURCE, a_ptrToCallback);
+		Timer_setSourceCallback(TIMER2_COMP_SOURCE, a_ptrToCallback);
 		break;
 	}
 }
 
+void Timer_setSourceCallback(Timer_Source a_source, void (*a_ptrToCallback)(void)) {
+	if (a_source < TIMER_SOURCES_COUNT) {
+		g_Timer_callbacks[a_source] = a_ptrToCallback;
+	}
+}
+
+void Timer_enableInterrupt(Timer_Source a_source) {
+	if (a_source < TIMER_SOURCES_COUNT) {
+		TIMSK |= g_Timer_sourceMasks[a_source];
+	}
+}
+
+void Timer_disableInterrupt(Timer_Source a_source) {
+	if (a_source < TIMER_SOURCES_COUNT) {
+		TIMSK &= ~g_Timer_sourceMasks[a_source];
+	}
+}
+
 void Timer_setCompareValue(uint8 a_Timer_ID, uint16 a_CompareVal) {
 	/* Sets a new compare value in OCR register according to timer ID*/
 	switch (a_Timer_ID) {
@@ -202,6 +273,21 @@ void Timer_setCompareValue(uint8 a_Timer_ID, uint16 a_CompareVal) {
 		break;
 	}
 }
+
+void Timer_setCompareBValue(uint16 a_CompareVal) {
+	OCR1B = a_CompareVal;
+}
+
+void Timer_setCaptureEdge(Timer_Edge a_edge, boolean a_noiseCanceler) {
+	/* ICES1 = edge select, ICNC1 = noise canceler, other bits are preserved */
+	TCCR1B = (TCCR1B & ~((1 << ICES1) | (1 << ICNC1))) | (a_edge << ICES1)
+			| (a_noiseCanceler << ICNC1);
+}
+
+uint16 Timer_getCaptureValue(void) {
+	return ICR1;
+}
+
 uint16 Timer_getTimerValue(uint8 a_Timer_ID) {
 	switch (a_Timer_ID) {
 	case TIMER0_ID:
@@ -241,7 +327,7 @@ void Timer_resume(uint8 a_Timer_ID) {
 		TCCR1B |= (Timer1_Current_Clock & 0x07);
 		break;
 	case TIMER2_ID:
-		TCCR2 |= (Timer0_Current_Clock & 0x07);
+		TCCR2 |= (Timer2_Current_Clock & 0x07);
 		break;
 	}
 }
@@ -275,13 +361,14 @@ void Timer_DeInit(uint8 a_Timer_ID) {
 		TCCR1A = TCCR1B = 0;
 		TCNT1 = 0;
 		OCR1A = 0;
+		OCR1B = 0;
 		/* Disable interrupts */
-		TIMSK &= ~((1 << TOIE1) | (1 << OCIE1A));
+		TIMSK &= ~((1 << TOIE1) | (1 << OCIE1A) | (1 << OCIE1B) | (1 << TICIE1));
 		break;
 	case TIMER2_ID:
 		/* Clear timer registers */
-		TCCR0 = 0;
-		TCNT0 = 0;
+		TCCR2 = 0;
+		TCNT2 = 0;
 		OCR2 = 0;
 		/* Disable interrupts */
 		TIMSK &= ~((1 << TOIE2) | (1 << OCIE2));
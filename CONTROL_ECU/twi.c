@@ -14,6 +14,7 @@
 
 #include "twi.h"
 #include "common_macros.h"
+#include "profiler.h"
 #include <avr/io.h>
 #include <avr/interrupt.h>
 /*******************************************************************************
@@ -26,9 +27,11 @@ static volatile void (*g_TWI_callbackNotif)(void) = NULL_PTR;
  *                             ISR Definition                                  *
  *******************************************************************************/
 ISR(TWI_vect) {
+	PROFILE_BEGIN(PROBE_ISR_TWI);
 	if (g_TWI_callbackNotif != NULL_PTR) {
 		(*g_TWI_callbackNotif)();
 	}
+	PROFILE_END(PROBE_ISR_TWI);
 }
 
 /*******************************************************************************
@@ -46,6 +49,32 @@ static uint32 power(uint16 base, uint16 index) {
 	return result;
 }
 
+/*
+ * Description :
+ * Resets the TWI module after a timeout: the bus is released and the status
+ * goes back to TWI_NO_INFO.
+ * */
+static void twi_recover(void) {
+	TWCR = 0;
+	TWCR = (1 << TWEN) | (TWI_INTERRUPT_ENABLE << TWIE);
+}
+
+/*
+ * Description :
+ * Polls until the current bus operation completes (TWINT set) or the deadline
+ * passes.
+ * */
+static Timeout_StatusType twi_waitInt(const Timeout_DeadlineType *a_deadline,
+		Timeout_SiteType a_site) {
+	while (BIT_IS_CLEAR(TWCR, TWINT)) {
+		if (Timeout_check(a_deadline, a_site) != TIMEOUT_STATUS_OK) {
+			twi_recover();
+			return TIMEOUT_STATUS_EXPIRED;
+		}
+	}
+	return TIMEOUT_STATUS_OK;
+}
+
 void TWI_init(const TWI_ConfigType *Config) {
 
 	/* Set slave address for MCU*/
@@ -75,25 +104,35 @@ void TWI_init(const TWI_ConfigType *Config) {
 	TWCR = (1 << TWEN) | (TWI_INTERRUPT_ENABLE << TWIE);
 }
 
-void TWI_start(void) {
+Timeout_StatusType TWI_start(const Timeout_DeadlineType *a_deadline) {
 	/* TWINT = 1 -> Clear flag by logic 1
 	 * TWEN  = 1 -> To keep module enabled
 	 * TWSTA = 1 -> Send start bit
 	 **/
 	TWCR = (1 << TWEN) | (1 << TWSTA) | (1 << TWINT);
-	while (BIT_IS_CLEAR(TWCR, TWINT))
-		;
+	return twi_waitInt(a_deadline, TIMEOUT_SITE_TWI_START);
 }
 
-void TWI_stop(void) {
+Timeout_StatusType TWI_stop(const Timeout_DeadlineType *a_deadline) {
 	/* TWINT = 1 -> Clear flag by logic 1
 	 * TWEN  = 1 -> To keep module enabled
 	 * TWSTO = 1 -> Send stop bit
 	 **/
 	TWCR = (1 << TWEN) | (1 << TWSTO) | (1 << TWINT);
+	/* TWSTO is cleared by hardware once the stop bit is on the bus,
+	 * wait for it so a following start is not merged with this stop */
+	while (BIT_IS_SET(TWCR, TWSTO)) {
+		if (Timeout_check(a_deadline, TIMEOUT_SITE_TWI_STOP)
+				!= TIMEOUT_STATUS_OK) {
+			twi_recover();
+			return TIMEOUT_STATUS_EXPIRED;
+		}
+	}
+	return TIMEOUT_STATUS_OK;
 }
 
-void TWI_writeByte(uint8 a_data) {
+Timeout_StatusType TWI_writeByte(uint8 a_data,
+		const Timeout_DeadlineType *a_deadline) {
 	/* Load data into register */
 	TWDR = a_data;
 
@@ -103,12 +142,11 @@ void TWI_writeByte(uint8 a_data) {
 	TWCR = (1 << TWINT) | (1 << TWEN);
 
 	/* Poll until TWI is ready to send */
-	while (BIT_IS_CLEAR(TWCR, TWINT))
-		;
-
+	return twi_waitInt(a_deadline, TIMEOUT_SITE_TWI_WRITE);
 }
 
-uint8 TWI_readByteWithAck(void) {
+Timeout_StatusType TWI_readByteWithAck(uint8 *a_data,
+		const Timeout_DeadlineType *a_deadline) {
 	/* TWINT = 1 -> Clear flag by logic 1
 	 * TWEN  = 1 -> To keep module enabled
 	 * TWEA  = 1 -> Enable ACK
@@ -116,21 +154,26 @@ uint8 TWI_readByteWithAck(void) {
 	TWCR = (1 << TWINT) | (1 << TWEN) | (1 << TWEA);
 
 	/* Poll until TWI is ready to send */
-	while (BIT_IS_CLEAR(TWCR, TWINT))
-		;
-	return TWDR;
+	if (twi_waitInt(a_deadline, TIMEOUT_SITE_TWI_READ) != TIMEOUT_STATUS_OK) {
+		return TIMEOUT_STATUS_EXPIRED;
+	}
+	*a_data = TWDR;
+	return TIMEOUT_STATUS_OK;
 }
 
-uint8 TWI_readByteWithNack(void) {
+Timeout_StatusType TWI_readByteWithNack(uint8 *a_data,
+		const Timeout_DeadlineType *a_deadline) {
 	/* TWINT = 1 -> Clear flag by logic 1
 	 * TWEN  = 1 -> To keep module enabled
 	 **/
 	TWCR = (1 << TWINT) | (1 << TWEN);
 
 	/* Poll until TWI is ready to send */
-	while (BIT_IS_CLEAR(TWCR, TWINT))
-		;
-	return TWDR;
+	if (twi_waitInt(a_deadline, TIMEOUT_SITE_TWI_READ) != TIMEOUT_STATUS_OK) {
+		return TIMEOUT_STATUS_EXPIRED;
+	}
+	*a_data = TWDR;
+	return TIMEOUT_STATUS_OK;
 }
 
 uint8 TWI_getStatus(void) {
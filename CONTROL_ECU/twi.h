@@ -15,6 +15,7 @@
 #ifndef TWI_H_
 #define TWI_H_
 #include "std_types.h"
+#include "timeout.h"
 /*******************************************************************************
  *                                Definitions                                  *
  *******************************************************************************/
@@ -36,6 +37,8 @@
 /*--Master Receive Data & (ACK/NACK)--*/
 #define TWI_MR_DATA_ACK 	(0x50)
 #define TWI_MR_DATA_NACK 	(0x58)
+/*--No relevant state: bus released after a timeout--*/
+#define TWI_NO_INFO 		(0xF8)
 
 /*******************************************************************************
  *                                Types Declarations                           *
@@ -82,20 +85,28 @@ void TWI_init(const TWI_ConfigType *Config);
  *
  * Description:  Sends start bit.
  * 		If start is sent twice, then it counts as repeated start.
- * Args: void
- * Returns: void
+ * 		---Note: On timeout (all calls below) the TWI module is reset to
+ * 		release the bus and TWI_getStatus returns TWI_NO_INFO.
+ * Args:
+ * 		[in] const Timeout_DeadlineType *a_deadline
+ * 			Deadline, TIMEOUT_FOREVER to wait without bound.
+ * 		[out] N/A
+ * Returns: Timeout_StatusType
  *******************************************************************************/
-void TWI_start(void);
+Timeout_StatusType TWI_start(const Timeout_DeadlineType *a_deadline);
 
 /******************************************************************************
  *
  * Function Name: TWI_stop
  *
  * Description: Sends stop bit to terminate frame.
- * Args: void
- * Returns: void
+ * Args:
+ * 		[in] const Timeout_DeadlineType *a_deadline
+ * 			Deadline, TIMEOUT_FOREVER to wait without bound.
+ * 		[out] N/A
+ * Returns: Timeout_StatusType
  *******************************************************************************/
-void TWI_stop(void);
+Timeout_StatusType TWI_stop(const Timeout_DeadlineType *a_deadline);
 
 /******************************************************************************
  *
@@ -106,10 +117,13 @@ void TWI_stop(void);
  *
  * 		[in] a_data
  * 			Byte which is sent from TWI.
+ * 			 const Timeout_DeadlineType *a_deadline
+ * 			Deadline, TIMEOUT_FOREVER to wait without bound.
  * 		[out] N/A
- * Returns: void
+ * Returns: Timeout_StatusType
  *******************************************************************************/
-void TWI_writeByte(uint8 a_data);
+Timeout_StatusType TWI_writeByte(uint8 a_data,
+		const Timeout_DeadlineType *a_deadline);
 
 /******************************************************************************
  *
@@ -117,23 +131,33 @@ void TWI_writeByte(uint8 a_data);
  *
  * Description:  Reads a byte from TWI and awaits ACK from slave.
  *
- * Args: void
- * Returns: uint8
+ * Args:
+ * 		[in] const Timeout_DeadlineType *a_deadline
+ * 			Deadline, TIMEOUT_FOREVER to wait without bound.
+ * 		[out] uint8 *a_data
+ * 			Byte read, untouched on timeout.
+ * Returns: Timeout_StatusType
  *
  *******************************************************************************/
-uint8 TWI_readByteWithAck(void);
+Timeout_StatusType TWI_readByteWithAck(uint8 *a_data,
+		const Timeout_DeadlineType *a_deadline);
 
 /******************************************************************************
  *
- * Function Name: TWI_readByteWithAck
+ * Function Name: TWI_readByteWithNack
  *
  * Description:  Reads a byte from TWI and awaits NACK from slave.
  *
- * Args: void
- * Returns: uint8
+ * Args:
+ * 		[in] const Timeout_DeadlineType *a_deadline
+ * 			Deadline, TIMEOUT_FOREVER to wait without bound.
+ * 		[out] uint8 *a_data
+ * 			Byte read, untouched on timeout.
+ * Returns: Timeout_StatusType
  *
  *******************************************************************************/
-uint8 TWI_readByteWithNack(void);
+Timeout_StatusType TWI_readByteWithNack(uint8 *a_data,
+		const Timeout_DeadlineType *a_deadline);
 
 /******************************************************************************
  *
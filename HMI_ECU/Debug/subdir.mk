@@ -4,24 +4,45 @@
 
 # Add inputs and outputs from these tool invocations to the build variables 
 C_SRCS += \
+../glyph.c \
 ../gpio.c \
 ../hmi_main.c \
 ../keypad.c \
 ../lcd.c \
+../messages.c \
+../profiler.c \
+../scheduler.c \
+../systick.c \
+../timeout.c \
+../timer.c \
 ../uart.c 
 
 OBJS += \
+./glyph.o \
 ./gpio.o \
 ./hmi_main.o \
 ./keypad.o \
 ./lcd.o \
+./messages.o \
+./profiler.o \
+./scheduler.o \
+./systick.o \
+./timeout.o \
+./timer.o \
 ./uart.o 
 
 C_DEPS += \
+./glyph.d \
 ./gpio.d \
 ./hmi_main.d \
 ./keypad.d \
 ./lcd.d \
+./messages.d \
+./profiler.d \
+./scheduler.d \
+./systick.d \
+./timeout.d \
+./timer.d \
 ./uart.d 
 
 
@@ -29,7 +50,7 @@ C_DEPS += \
 %.o: ../%.c subdir.mk
 	@echo 'Building file: $<'
 	@echo 'Invoking: AVR Compiler'
-	avr-gcc -DF_CPU=8000000UL -DDF_CPU=8000000UL -Wall -g2 -gstabs -O0 -fpack-struct -fshort-enums -ffunction-sections -fdata-sections -std=gnu99 -funsigned-char -funsigned-bitfields -mmcu=atmega16 -DF_CPU=1000000UL -MMD -MP -MF"$(@:%.o=%.d)" -MT"$@" -c -o "$@" "$<"
+	avr-gcc -Wall -g2 -gstabs -O0 -fpack-struct -fshort-enums -ffunction-sections -fdata-sections -std=gnu99 -funsigned-char -funsigned-bitfields -mmcu=atmega16 -DF_CPU=8000000UL -MMD -MP -MF"$(@:%.o=%.d)" -MT"$@" -c -o "$@" "$<"
 	@echo 'Finished building: $<'
 	@echo ' '
 
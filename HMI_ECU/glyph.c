@@ -0,0 +1,95 @@
+/******************************************************************************
+ *
+ * Module: Glyph
+ *
+ * File Name: glyph.c
+ *
+ * Description: Source file for the LCD custom glyph cache.
+ *
+ * Date Created: 18/10/2026
+ *
+ * Author: Hazem Montasser
+ *
+ *******************************************************************************/
+
+#include "glyph.h"
+#include "lcd.h"
+#include <avr/pgmspace.h>
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define GLYPH_NONE 			(0xFF)	/* Empty slot */
+
+/* Progress bar cell, n columns filled from the left, cursor line kept clear */
+#define GLYPH_BAR(n) \
+	{ (0x1F << (5 - (n))) & 0x1F, (0x1F << (5 - (n))) & 0x1F, \
+	  (0x1F << (5 - (n))) & 0x1F, (0x1F << (5 - (n))) & 0x1F, \
+	  (0x1F << (5 - (n))) & 0x1F, (0x1F << (5 - (n))) & 0x1F, \
+	  (0x1F << (5 - (n))) & 0x1F, 0x00 }
+
+/*******************************************************************************
+ *                         Global Variables(Private)                           *
+ *******************************************************************************/
+
+/* Indexed by Glyph_IdType */
+static const uint8 g_bitmaps[GLYPH_COUNT][GLYPH_ROWS] PROGMEM = {
+		{ 0x0E, 0x11, 0x11, 0x1F, 0x1B, 0x1B, 0x1F, 0x00 }, /* Lock */
+		{ 0x0E, 0x10, 0x10, 0x1F, 0x1B, 0x1B, 0x1F, 0x00 }, /* Unlock */
+		{ 0x04, 0x0E, 0x0E, 0x0E, 0x1F, 0x00, 0x04, 0x00 }, /* Alarm bell */
+		GLYPH_BAR(1),
+		GLYPH_BAR(2),
+		GLYPH_BAR(3),
+		GLYPH_BAR(4),
+		GLYPH_BAR(5) };
+
+static uint8 g_slot_glyph[GLYPH_SLOTS]; /* Glyph in each slot */
+static uint16 g_slot_used[GLYPH_SLOTS]; /* Use stamp of each slot */
+static uint16 g_stamp = 0; /* Incremented by every Glyph_get */
+static uint16 g_uploads = 0;
+
+/*******************************************************************************
+ *                              Functions Definitions                          *
+ *******************************************************************************/
+
+void Glyph_init(void) {
+	for (uint8 slot = 0; slot < GLYPH_SLOTS; slot++) {
+		g_slot_glyph[slot] = GLYPH_NONE;
+		g_slot_used[slot] = 0;
+	}
+	g_stamp = 0;
+	g_uploads = 0;
+}
+
+uint8 Glyph_get(Glyph_IdType a_id) {
+	uint8 victim = 0;
+	uint16 oldest = 0;
+	uint16 age;
+	if (a_id >= GLYPH_COUNT) {
+		return ' ';
+	}
+	g_stamp++;
+	for (uint8 slot = 0; slot < GLYPH_SLOTS; slot++) {
+		if (g_slot_glyph[slot] == a_id) {
+			g_slot_used[slot] = g_stamp;
+			return GLYPH_CHAR_BASE + slot;
+		}
+		/* An empty slot is older than any used one, ages survive the stamp wrap */
+		age = (g_slot_glyph[slot] == GLYPH_NONE) ?
+				0xFFFF : (uint16) (g_stamp - g_slot_used[slot]);
+		if (age > oldest) {
+			oldest = age;
+			victim = slot;
+		}
+	}
+	LCD_defineCharacter_P(victim, g_bitmaps[a_id]);
+	g_slot_glyph[victim] = a_id;
+	g_slot_used[victim] = g_stamp;
+	g_uploads++;
+	return GLYPH_CHAR_BASE + victim;
+}
+
+uint16 Glyph_getUploads(void) {
+	return g_uploads;
+}
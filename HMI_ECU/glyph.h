@@ -0,0 +1,97 @@
+/******************************************************************************
+ *
+ * Module: Glyph
+ *
+ * File Name: glyph.h
+ *
+ * Description: Header file for the LCD custom glyph cache.
+ *
+ * 				The HD44780 holds 8 custom 5x8 characters in its CGRAM. The
+ * 				glyphs (bitmaps in flash) are uploaded on demand by Glyph_get,
+ * 				a resident glyph is never uploaded again and a new one replaces
+ * 				the least recently used slot.
+ *
+ * 				A glyph replaced while it is still on the screen changes there
+ * 				too, so a screen should not use more than GLYPH_SLOTS glyphs.
+ *
+ * Date Created: 18/10/2026
+ *
+ * Author: Hazem Montasser
+ *
+ *******************************************************************************/
+
+#ifndef GLYPH_H_
+#define GLYPH_H_
+
+#include "std_types.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define GLYPH_SLOTS 			(8U)	/* CGRAM characters */
+#define GLYPH_ROWS 				(8U)	/* Bytes of a 5x8 glyph, bits 4-0 from left to right */
+#define GLYPH_BAR_COLUMNS 		(5U)	/* Pixel columns of a progress bar cell */
+#define GLYPH_CHAR_BASE 		(0x08)	/* Character code of slot 0, codes 8-15 address the
+										 * same CGRAM as 0-7 without the string terminator */
+
+/*******************************************************************************
+ *                               Types Declaration                             *
+ *******************************************************************************/
+
+/* Glyph IDs, index of the bitmap table */
+typedef enum {
+	GLYPH_LOCK,
+	GLYPH_UNLOCK,
+	GLYPH_ALARM,
+	GLYPH_BAR_1, /* Progress bar cell with 1 to 5 columns filled */
+	GLYPH_BAR_2,
+	GLYPH_BAR_3,
+	GLYPH_BAR_4,
+	GLYPH_BAR_5,
+	GLYPH_COUNT
+} Glyph_IdType;
+
+/*******************************************************************************
+ *                              Functions Prototypes                           *
+ *******************************************************************************/
+
+/******************************************************************************
+ *
+ * Function Name: Glyph_init
+ *
+ * Description: Empties every slot, the CGRAM content is unknown.
+ * 		---Note: LCD_init must be called before this function.
+ *
+ *******************************************************************************/
+void Glyph_init(void);
+
+/******************************************************************************
+ *
+ * Function Name: Glyph_get
+ *
+ * Description: Returns the character code of a glyph for the LCD functions,
+ * 		uploading it to the least recently used slot if it is not resident.
+ * 		The upload goes through the LCD background writer (9 bytes).
+ *
+ * Args:
+ *
+ * 		[in] Glyph_IdType a_id
+ * 			Glyph to show, less than GLYPH_COUNT.
+ * 		[out] N/A
+ * Returns: uint8
+ * 		GLYPH_CHAR_BASE + slot, ' ' for an invalid ID.
+ *
+ *******************************************************************************/
+uint8 Glyph_get(Glyph_IdType a_id);
+
+/******************************************************************************
+ *
+ * Function Name: Glyph_getUploads
+ *
+ * Description: Returns the number of glyphs uploaded since Glyph_init.
+ *
+ *******************************************************************************/
+uint16 Glyph_getUploads(void);
+
+#endif /* GLYPH_H_ */
@@ -13,6 +13,85 @@
 #include "gpio.h"
 #include "common_macros.h" /* To use the macros like SET_BIT */
 #include "avr/io.h" /* To use the IO Ports Registers */
+#include "systick.h" /* To time stamp and debounce input events */
+#include <avr/interrupt.h> /* For the external interrupts ISRs */
+
+#if (GPIO_EVENT_QUEUE_SIZE & (GPIO_EVENT_QUEUE_SIZE - 1)) != 0
+#error "GPIO_EVENT_QUEUE_SIZE must be a power of 2"
+#endif
+
+/*******************************************************************************
+ *                         Global Variables(Private)                           *
+ *******************************************************************************/
+
+/* GICR enable bit of each line, the GIFR flag INTFn has the same position */
+static const uint8 g_extIntBits[GPIO_EXT_INT_COUNT] = { INT0, INT1, INT2 };
+static void (*volatile g_extIntCallbacks[GPIO_EXT_INT_COUNT])(void) = {
+		NULL_PTR, NULL_PTR, NULL_PTR };
+static uint8 g_debounce_ms[GPIO_EXT_INT_COUNT]; /* Debounce time of each line */
+static uint32 g_last_event_ms[GPIO_EXT_INT_COUNT]; /* Time of the last accepted event */
+static boolean g_event_seen[GPIO_EXT_INT_COUNT]; /* An event was accepted since setup */
+
+/* Input events ring, written by the ISRs, read by GPIO_getEvent.
+ * The indices run freely, the slot is the index modulo the size */
+static GPIO_EventType g_events[GPIO_EVENT_QUEUE_SIZE];
+static volatile uint8 g_event_head = 0; /* Next slot written */
+static volatile uint8 g_event_tail = 0; /* Next slot read */
+static volatile uint8 g_event_overflows = 0; /* Events dropped, queue full */
+
+/*******************************************************************************
+ *                      Functions Definitions (Private)                        *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Common part of the external interrupt ISRs: drops the interrupt if it is
+ * within the debounce time of the last accepted one, otherwise queues the event
+ * and calls the line callback.
+ */
+static void gpio_extIntEvent(GPIO_ExtIntType line, uint8 level) {
+	uint32 now = SysTick_getMillis();
+	GPIO_EventType *event;
+
+	if (g_event_seen[line]
+			&& (uint32) (now - g_last_event_ms[line]) < g_debounce_ms[line]) {
+		return;
+	}
+	g_event_seen[line] = TRUE;
+	g_last_event_ms[line] = now;
+	if ((uint8) (g_event_head - g_event_tail) < GPIO_EVENT_QUEUE_SIZE) {
+		event = &g_events[g_event_head & (GPIO_EVENT_QUEUE_SIZE - 1)];
+		event->Line = line;
+		event->Level = level;
+		event->Time_ms = now;
+		g_event_head++;
+	} else if (g_event_overflows != 0xFF) {
+		g_event_overflows++;
+	}
+	if (g_extIntCallbacks[line] != NULL_PTR) {
+		(*g_extIntCallbacks[line])();
+	}
+}
+
+/*******************************************************************************
+ *                       Interrupt Service Routines                            *
+ *******************************************************************************/
+
+ISR(INT0_vect) {
+	gpio_extIntEvent(GPIO_INT0, GPIO_READ_PIN(GPIO_INT0_PORT_ID, GPIO_INT0_PIN_ID));
+}
+
+ISR(INT1_vect) {
+	gpio_extIntEvent(GPIO_INT1, GPIO_READ_PIN(GPIO_INT1_PORT_ID, GPIO_INT1_PIN_ID));
+}
+
+ISR(INT2_vect) {
+	gpio_extIntEvent(GPIO_INT2, GPIO_READ_PIN(GPIO_INT2_PORT_ID, GPIO_INT2_PIN_ID));
+}
+
+/*******************************************************************************
+ *                              Functions Definitions                          *
+ *******************************************************************************/
 
 /*
  * Description :
@@ -250,3 +329,109 @@ uint8 GPIO_readPort(uint8 port_num) {
 	}
 	return port_value;
 }
+
+/*
+ * Description :
+ * Setup an external interrupt line: the pin as input (with optional pull-up),
+ * the sense and the debounce time, then enable its interrupt.
+ * Returns FALSE if the line is not correct or INT2 is given a non-edge sense.
+ */
+boolean GPIO_setupExtInt(const GPIO_ExtIntConfigType *config_ptr) {
+	GPIO_ExtIntType line = config_ptr->Line;
+	uint8 port_num;
+	uint8 pin_num;
+
+	if ((line >= GPIO_EXT_INT_COUNT)
+			|| ((line == GPIO_INT2) && (config_ptr->Sense < GPIO_SENSE_FALLING))) {
+		return FALSE;
+	}
+	/* Changing the sense may raise the flag: disable the line first */
+	GPIO_disableExtInt(line);
+	g_debounce_ms[line] = config_ptr->Debounce_ms;
+	g_event_seen[line] = FALSE;
+
+	switch (line) {
+	case GPIO_INT0:
+		port_num = GPIO_INT0_PORT_ID;
+		pin_num = GPIO_INT0_PIN_ID;
+		MCUCR = (MCUCR & ~((1 << ISC01) | (1 << ISC00)))
+				| (config_ptr->Sense << ISC00);
+		break;
+	case GPIO_INT1:
+		port_num = GPIO_INT1_PORT_ID;
+		pin_num = GPIO_INT1_PIN_ID;
+		MCUCR = (MCUCR & ~((1 << ISC11) | (1 << ISC10)))
+				| (config_ptr->Sense << ISC10);
+		break;
+	default:
+		port_num = GPIO_INT2_PORT_ID;
+		pin_num = GPIO_INT2_PIN_ID;
+		if (config_ptr->Sense == GPIO_SENSE_RISING) {
+			SET_BIT(MCUCSR, ISC2);
+		} else {
+			CLEAR_BIT(MCUCSR, ISC2);
+		}
+		break;
+	}
+	GPIO_setupPinDirection(port_num, pin_num, PIN_INPUT);
+	GPIO_writePin(port_num, pin_num,
+			config_ptr->PullUp ? LOGIC_HIGH : LOGIC_LOW);
+
+	/* Drop an edge latched before the setup, then enable (flag cleared by writing 1) */
+	GIFR = (1 << g_extIntBits[line]);
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		SET_BIT(GICR, g_extIntBits[line]);
+	}
+	return TRUE;
+}
+
+/*
+ * Description :
+ * Disable the interrupt of an external interrupt line, the pin is left as is.
+ */
+void GPIO_disableExtInt(GPIO_ExtIntType line) {
+	if (line < GPIO_EXT_INT_COUNT) {
+		ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+		{
+			CLEAR_BIT(GICR, g_extIntBits[line]);
+		}
+	}
+}
+
+/*
+ * Description :
+ * Set the function called from the ISR of an external interrupt line after
+ * the event is queued (NULL_PTR = none).
+ */
+void GPIO_setExtIntCallback(GPIO_ExtIntType line, void (*a_ptrToCallback)(void)) {
+	if (line < GPIO_EXT_INT_COUNT) {
+		g_extIntCallbacks[line] = a_ptrToCallback;
+	}
+}
+
+/*
+ * Description :
+ * Take the oldest input event from the queue.
+ * Returns FALSE (event_ptr untouched) if the queue is empty.
+ */
+boolean GPIO_getEvent(GPIO_EventType *event_ptr) {
+	boolean found = FALSE;
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		if (g_event_tail != g_event_head) {
+			*event_ptr = g_events[g_event_tail & (GPIO_EVENT_QUEUE_SIZE - 1)];
+			g_event_tail++;
+			found = TRUE;
+		}
+	}
+	return found;
+}
+
+/*
+ * Description :
+ * Return the number of events dropped because the queue was full.
+ */
+uint8 GPIO_getEventOverflows(void) {
+	return g_event_overflows;
+}
@@ -14,6 +14,9 @@
 #define GPIO_H_
 
 #include "std_types.h"
+#include "common_macros.h" /* To use the macros like SET_BIT */
+#include <avr/io.h> /* To use the IO Ports Registers */
+#include <util/atomic.h> /* To use ATOMIC_BLOCK */
 
 /*******************************************************************************
  *                                Definitions                                  *
@@ -35,6 +38,16 @@
 #define PIN6_ID                6
 #define PIN7_ID                7
 
+/* External interrupt pins */
+#define GPIO_INT0_PORT_ID      PORTD_ID
+#define GPIO_INT0_PIN_ID       PIN2_ID
+#define GPIO_INT1_PORT_ID      PORTD_ID
+#define GPIO_INT1_PIN_ID       PIN3_ID
+#define GPIO_INT2_PORT_ID      PORTB_ID
+#define GPIO_INT2_PIN_ID       PIN2_ID
+
+#define GPIO_EVENT_QUEUE_SIZE  8	/* Debounced input events buffered, power of 2 */
+
 /*******************************************************************************
  *                               Types Declaration                             *
  *******************************************************************************/
@@ -46,6 +59,32 @@ typedef enum {
 	PORT_INPUT, PORT_OUTPUT = 0xFF
 } GPIO_PortDirectionType;
 
+typedef enum {
+	GPIO_INT0, GPIO_INT1, GPIO_INT2, GPIO_EXT_INT_COUNT
+} GPIO_ExtIntType;
+
+/* Interrupt sense, the values are the ISCn1:ISCn0 bits.
+ * INT2 senses edges only (GPIO_SENSE_FALLING/GPIO_SENSE_RISING).
+ * GPIO_SENSE_LOW_LEVEL interrupts as long as the pin is low (the events are
+ * debounced, the interrupts are not): disable the line from its callback. */
+typedef enum {
+	GPIO_SENSE_LOW_LEVEL, GPIO_SENSE_ANY_EDGE, GPIO_SENSE_FALLING, GPIO_SENSE_RISING
+} GPIO_SenseType;
+
+typedef struct {
+	GPIO_ExtIntType Line;
+	GPIO_SenseType Sense;
+	boolean PullUp; /* Enable the internal pull-up (switch to ground) */
+	uint8 Debounce_ms; /* Edges closer than this to the last accepted one are dropped */
+} GPIO_ExtIntConfigType;
+
+/* One debounced edge or level detected on an external interrupt line */
+typedef struct {
+	uint8 Line; /* GPIO_ExtIntType */
+	uint8 Level; /* Pin level read in the ISR, LOGIC_HIGH/LOGIC_LOW */
+	uint32 Time_ms; /* SysTick_getMillis() in the ISR */
+} GPIO_EventType;
+
 /*******************************************************************************
  *                              Functions Prototypes                           *
  *******************************************************************************/
@@ -98,4 +137,166 @@ void GPIO_writePort(uint8 port_num, uint8 value);
  */
 uint8 GPIO_readPort(uint8 port_num);
 
+/*
+ * Description :
+ * Setup an external interrupt line: the pin as input (with optional pull-up),
+ * the sense and the debounce time, then enable its interrupt.
+ * Every debounced interrupt is queued as a GPIO_EventType and the line callback
+ * (if any) is called from the ISR, e.g. to wake up a task.
+ * Returns FALSE if the line is not correct or INT2 is given a non-edge sense.
+ */
+boolean GPIO_setupExtInt(const GPIO_ExtIntConfigType *config_ptr);
+
+/*
+ * Description :
+ * Disable the interrupt of an external interrupt line, the pin is left as is.
+ */
+void GPIO_disableExtInt(GPIO_ExtIntType line);
+
+/*
+ * Description :
+ * Set the function called from the ISR of an external interrupt line after
+ * the event is queued (NULL_PTR = none).
+ */
+void GPIO_setExtIntCallback(GPIO_ExtIntType line, void (*a_ptrToCallback)(void));
+
+/*
+ * Description :
+ * Take the oldest input event from the queue.
+ * Returns FALSE (event_ptr untouched) if the queue is empty.
+ * While the CPU sleeps in tickless idle the clock is not advanced before the
+ * ISR runs, so the event time (and the debounce window) may lag by up to the
+ * sleep length (SYSTICK_SLEEP_MAX_MS).
+ */
+boolean GPIO_getEvent(GPIO_EventType *event_ptr);
+
+/*
+ * Description :
+ * Return the number of events dropped because the queue was full.
+ */
+uint8 GPIO_getEventOverflows(void);
+
+/*******************************************************************************
+ *                        Compile-time Pin Accessors                           *
+ *******************************************************************************/
+
+/*
+ * Registers of a port ID. With a constant ID the conditions fold at compile
+ * time to a constant I/O address, so the bit macros below compile to single
+ * SBI/CBI/SBIC instructions when optimizing (a load-modify-store at -O0),
+ * instead of the range checks and switch of the runtime API.
+ */
+#define GPIO_PORT_REG(port_num) \
+	(*((port_num) == PORTA_ID ? &PORTA : (port_num) == PORTB_ID ? &PORTB : \
+		(port_num) == PORTC_ID ? &PORTC : &PORTD))
+#define GPIO_DDR_REG(port_num) \
+	(*((port_num) == PORTA_ID ? &DDRA : (port_num) == PORTB_ID ? &DDRB : \
+		(port_num) == PORTC_ID ? &DDRC : &DDRD))
+#define GPIO_PIN_REG(port_num) \
+	(*((port_num) == PORTA_ID ? &PINA : (port_num) == PORTB_ID ? &PINB : \
+		(port_num) == PORTC_ID ? &PINC : &PIND))
+
+/*
+ * Accesses of a constant port, the pin may vary. Drivers write the registers
+ * only through these, so a host build (GPIO_SIM defined, see
+ * host/gpio_sim.h) can route every access to the runtime API and record it.
+ */
+#ifndef GPIO_SIM
+#define GPIO_PIN_OUTPUT(port_num, pin_num)	SET_BIT(GPIO_DDR_REG(port_num), (pin_num))
+#define GPIO_PIN_INPUT(port_num, pin_num)	CLEAR_BIT(GPIO_DDR_REG(port_num), (pin_num))
+#define GPIO_PIN_HIGH(port_num, pin_num)	SET_BIT(GPIO_PORT_REG(port_num), (pin_num))
+#define GPIO_PIN_LOW(port_num, pin_num)		CLEAR_BIT(GPIO_PORT_REG(port_num), (pin_num))
+#define GPIO_WRITE_DDR(port_num, value)		(GPIO_DDR_REG(port_num) = (value))
+#define GPIO_WRITE_PORT(port_num, value)	(GPIO_PORT_REG(port_num) = (value))
+/* Level of the pin, LOGIC_HIGH/LOGIC_LOW */
+#define GPIO_READ_PIN(port_num, pin_num) \
+	(BIT_IS_SET(GPIO_PIN_REG(port_num), (pin_num)) ? LOGIC_HIGH : LOGIC_LOW)
+#define GPIO_READ_PORT(port_num)			(GPIO_PIN_REG(port_num))
+#else
+#define GPIO_PIN_OUTPUT(port_num, pin_num)	GPIO_setupPinDirection((port_num), (pin_num), PIN_OUTPUT)
+#define GPIO_PIN_INPUT(port_num, pin_num)	GPIO_setupPinDirection((port_num), (pin_num), PIN_INPUT)
+#define GPIO_PIN_HIGH(port_num, pin_num)	GPIO_writePin((port_num), (pin_num), LOGIC_HIGH)
+#define GPIO_PIN_LOW(port_num, pin_num)		GPIO_writePin((port_num), (pin_num), LOGIC_LOW)
+#define GPIO_WRITE_DDR(port_num, value)		GPIO_setupPortDirection((port_num), (value))
+#define GPIO_WRITE_PORT(port_num, value)	GPIO_writePort((port_num), (value))
+#define GPIO_READ_PIN(port_num, pin_num)	GPIO_readPin((port_num), (pin_num))
+#define GPIO_READ_PORT(port_num)			GPIO_readPort(port_num)
+#endif
+
+/* Fails the build (negative array size) if port/pin is not a valid pin */
+#define GPIO_PIN_ASSERT(port_num, pin_num, tag) \
+	typedef char gpio_invalid_pin_##tag \
+			[((port_num) < NUM_OF_PORTS && (pin_num) < NUM_OF_PINS_PER_PORT) ? 1 : -1]
+
+/*
+ * Defines the accessors of one pin, for pins fixed by a driver's configuration:
+ * 		GPIO_DEFINE_PIN(lcd_rs, LCD_CONTROL_PORT, LCD_RS);
+ * generates:
+ * 		lcd_rs_output(), lcd_rs_input()		Pin direction
+ * 		lcd_rs_high(), lcd_rs_low()			Output level (pull-up on inputs)
+ * 		lcd_rs_write(value)					LOGIC_HIGH/LOGIC_LOW
+ * 		lcd_rs_read()						LOGIC_HIGH/LOGIC_LOW
+ * The accessors are always inlined, so every call is the single instruction
+ * above at any optimization level, and the pin is checked at compile time.
+ */
+#define GPIO_DEFINE_PIN(name, port_num, pin_num) \
+	static inline __attribute__((always_inline)) void name##_output(void) { \
+		GPIO_PIN_OUTPUT(port_num, pin_num); \
+	} \
+	static inline __attribute__((always_inline)) void name##_input(void) { \
+		GPIO_PIN_INPUT(port_num, pin_num); \
+	} \
+	static inline __attribute__((always_inline)) void name##_high(void) { \
+		GPIO_PIN_HIGH(port_num, pin_num); \
+	} \
+	static inline __attribute__((always_inline)) void name##_low(void) { \
+		GPIO_PIN_LOW(port_num, pin_num); \
+	} \
+	static inline __attribute__((always_inline)) void name##_write(uint8 value) { \
+		if (value == LOGIC_HIGH) { \
+			GPIO_PIN_HIGH(port_num, pin_num); \
+		} else { \
+			GPIO_PIN_LOW(port_num, pin_num); \
+		} \
+	} \
+	static inline __attribute__((always_inline)) uint8 name##_read(void) { \
+		return GPIO_READ_PIN(port_num, pin_num); \
+	} \
+	GPIO_PIN_ASSERT(port_num, pin_num, name)
+
+/*******************************************************************************
+ *                            Atomic Port Writes                               *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Write the bits of value selected by mask on the required port, the other pins
+ * keep their output level (or pull-up) as held in the PORT register.
+ * The read-modify-write runs with interrupts disabled, so a port shared with an
+ * ISR is never corrupted and all the selected pins change on the same cycle.
+ * If the input port number is not correct, The function will not handle the request.
+ * With a constant port number the port is resolved at compile time.
+ */
+static inline __attribute__((always_inline)) void GPIO_writePortMasked(
+		uint8 port_num, uint8 mask, uint8 value) {
+	if (port_num < NUM_OF_PORTS) {
+		ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+		{
+			GPIO_WRITE_PORT(port_num,
+					(GPIO_PORT_REG(port_num) & ~mask) | (value & mask));
+		}
+	}
+}
+
+/*
+ * Description :
+ * Drive the pins in high_pins to Logic High and the pins in low_pins to Logic
+ * Low on the required port, in one atomic write (see GPIO_writePortMasked).
+ * A pin in both masks is driven high.
+ */
+static inline __attribute__((always_inline)) void GPIO_writePinsAtomic(
+		uint8 port_num, uint8 high_pins, uint8 low_pins) {
+	GPIO_writePortMasked(port_num, high_pins | low_pins, high_pins);
+}
+
 #endif /* GPIO_H_ */
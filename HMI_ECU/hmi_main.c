@@ -15,133 +15,464 @@
 
 #define F_CPU (8000000UL)
 #include <avr/io.h>
-#include <util/delay.h>
+#include <avr/interrupt.h>	/* To use sei() */
 
 /* Module headers */
+#include "systick.h"
+#include "scheduler.h"
+#include "profiler.h"
 #include "uart.h"
 #include "lcd.h"
 #include "keypad.h"
+#include "messages.h"
+#include "glyph.h"
 #include "std_types.h"
 #include "../CONTROL_ECU/system_modes.h"
+
+/*******************************************************************************
+ *                                      Definitions                            *
+ *******************************************************************************/
+/* Tasks, the ID is the priority (0 = highest) */
+#define TASK_LINK 				(0U)	/* Parses bytes received from Control ECU */
+#define TASK_KEYPAD 			(1U)	/* Scans & debounces the keypad */
+#define TASK_DISPLAY 			(2U)	/* Draws the current screen on the LCD */
+
+/* Task events */
+#define EVENT_RX 				(0x01)	/* TASK_LINK: byte received */
+#define EVENT_REDRAW 			(0x01)	/* TASK_DISPLAY: screen changed */
+#define EVENT_ECHO 				(0x02)	/* TASK_DISPLAY: password key entered */
+
+#define KEYPAD_SCAN_PERIOD_MS 	(20U)	/* Keypad scan period */
+#define KEYPAD_DEBOUNCE_SCANS 	(2U)	/* Scans a key must stay stable to count */
+
+/* Progress bars of the door and alarm screens. The durations are the defaults
+ * of the Control ECU configuration (config.c), the screens still end on its
+ * SYNC: a bar stays full if the phase takes longer. */
+#define PROGRESS_PERIOD_MS 		(200U)	/* Redraw period while a bar is shown */
+#define PROGRESS_STEPS 			(LCD_MAX_COLS * GLYPH_BAR_COLUMNS)	/* One per pixel column */
+#define DOOR_UNLOCK_MS 			(18000UL)	/* Door opening (15s) and held open (3s) */
+#define DOOR_LOCK_MS 			(15000UL)	/* Door closing */
+#define ALARM_MS 				(60000UL)	/* Buzzer time */
+
+/*******************************************************************************
+ *                               Types Declaration                             *
+ *******************************************************************************/
+/* Screens drawn by the display task */
+typedef enum {
+	SCREEN_FIRST_BOOT_1,
+	SCREEN_FIRST_BOOT_2,
+	SCREEN_MAIN_MENU,
+	SCREEN_LOCKED,
+	SCREEN_ALARM,
+	SCREEN_DOOR_UNLOCKING,
+	SCREEN_DOOR_LOCKING
+} HMI_ScreenType;
+
+/* Reply awaited from Control ECU */
+typedef enum {
+	REPLY_NONE, /* Idle, keys are accepted */
+	REPLY_FIRST_BOOT, /* SYNC, passwords match */
+	REPLY_ATTEMPT, /* Password correct, next status */
+	REPLY_DOOR, /* SYNC when locking starts, SYNC when door is closed */
+	REPLY_ALARM /* SYNC, next status */
+} HMI_ReplyType;
+
 /*******************************************************************************
  *                            Global Variables (Private)				       *
  *******************************************************************************/
 static uint8 g_password_buffer[PASSWORD_LENGTH]; /* Buffer for entered passwords by the user*/
 static uint8 HMI_status = MODE_FIRST_BOOT; /* HMI initial status */
+static HMI_ScreenType g_screen = SCREEN_FIRST_BOOT_1; /* Screen shown on the LCD */
+static HMI_ReplyType g_reply = REPLY_NONE; /* Reply awaited from Control ECU */
+static uint8 g_reply_index = 0; /* Bytes of the awaited reply received so far */
+static uint8 g_password_match = FALSE; /* First byte of an attempt reply */
+static boolean g_entry_active = FALSE; /* Keys are taken as password characters */
+static uint8 g_entry_index = 0; /* Password characters entered so far */
+static uint8 g_request = 0; /* Request sent from the main menu */
+static uint32 g_screen_start_ms = 0; /* System tick time the screen was shown */
 /*******************************************************************************
  *                           Functions Definitions (Private)      		       *
  *******************************************************************************/
-/*
- * Description :
- * Gets the password from the user through keypad presses.
- * Displays * on the screen for every press entered.
- * Sends Sync and password string to control ECU for processing.
- *
- * UART_SENDS# = 2
- * UART_REC#   = 0
- */
-static void getSendPasswordSync(void) {
-	/* For every keypad press, print asterisk and store pressed key*/
-	for (uint8 i = 0; i < PASSWORD_LENGTH - 2; i++) {
-		g_password_buffer[i] = KEYPAD_getPressedKey();
-		/* Adjust number to contain ASCII if its a number so that the number '0'
-		 * is not counted as a null terminator character,
-		 * if it's a symbol like '#','+','*'... then no need to adjust.
-		 * */
-		if (g_password_buffer[i] < 10) {
-			g_password_buffer[i] += '0';
-		}
-		LCD_displayCharacter('*');
-		_delay_ms(400);
-	};
-	/* Send password after syncing with control */
-	UART_sendByte(SYNC_HANDSHAKE);
-	UART_sendString(g_password_buffer);
-
-}
 /*
  * Description :
  * Displays first boot menu for password entry try #1
  */
 static void printFirstBootMenu1(void) {
-	LCD_clearScreen();
-	LCD_displayString((const uint8*) "Please enter");
-	LCD_displayStringRowColumn(LCD_ROW_1, 0, (const uint8*) "new pass: ");
+	LCD_frameClear();
+	LCD_frameString_P(Message_get(MESSAGE_PLEASE_ENTER));
+	LCD_frameStringRowColumn_P(LCD_ROW_1, 0, Message_get(MESSAGE_NEW_PASS));
 }
 /*
  * Description :
  * Displays first boot menu for password entry try #2
  */
 static void printFirstBootMenu2(void) {
-	LCD_clearScreen();
-	LCD_displayString((const uint8*) "Please re-enter");
-	LCD_displayStringRowColumn(LCD_ROW_1, 0, (const uint8*) "new pass: ");
+	LCD_frameClear();
+	LCD_frameString_P(Message_get(MESSAGE_PLEASE_REENTER));
+	LCD_frameStringRowColumn_P(LCD_ROW_1, 0, Message_get(MESSAGE_NEW_PASS));
 }
 /*
  * Description :
  * Print options for the user on LCD.
  */
 static void printMainMenu(void) {
-	LCD_clearScreen();
-	LCD_displayString((const uint8*) "+ : Open door");
-	LCD_displayStringRowColumn(LCD_ROW_1, 0, (const uint8*) "- : Change pass");
+	LCD_frameClear();
+	LCD_frameString_P(Message_get(MESSAGE_OPEN_DOOR));
+	LCD_frameStringRowColumn_P(LCD_ROW_1, 0, Message_get(MESSAGE_CHANGE_PASS));
 }
 /*
  * Description :
  * Prints password prompt message for the user on LCD.
  */
 static void printLockedMenu(void) {
-	LCD_clearScreen();
-	LCD_displayString((const uint8*) "Enter pass: ");
-	LCD_moveCursor(LCD_ROW_1, 0);
+	LCD_frameClear();
+	LCD_frameString_P(Message_get(MESSAGE_ENTER_PASS));
+	LCD_frameMoveCursor(LCD_ROW_0, LCD_MAX_COLS - 1);
+	LCD_frameCharacter(Glyph_get(GLYPH_LOCK));
+	LCD_frameMoveCursor(LCD_ROW_1, 0);
 }
 /*
  * Description :
  * Error message for alarm mode when password is entered incorrectly
  */
 static void printAlarmMessage(void) {
-	LCD_clearScreen();
-	LCD_displayString((const uint8*) "   !!!ERROR!!!");
+	LCD_frameClear();
+	LCD_frameString_P(Message_get(MESSAGE_ERROR));
+	LCD_frameMoveCursor(LCD_ROW_0, 0);
+	LCD_frameCharacter(Glyph_get(GLYPH_ALARM));
+	LCD_frameMoveCursor(LCD_ROW_0, LCD_MAX_COLS - 1);
+	LCD_frameCharacter(Glyph_get(GLYPH_ALARM));
 }
 /*
  * Description :
  * Prints the door status for the user on LCD while unlocking.
  */
 static void printDoorUnlockingMessage(void) {
-	LCD_clearScreen();
-	LCD_displayString((const uint8*) "Door is");
-	LCD_displayStringRowColumn(LCD_ROW_1, 0, (const uint8*) "unlocking...");
+	LCD_frameClear();
+	LCD_frameCharacter(Glyph_get(GLYPH_UNLOCK));
+	LCD_frameStringRowColumn_P(LCD_ROW_0, 2, Message_get(MESSAGE_UNLOCKING));
 }
 /*
  * Description :
  * Prints the door status for the user on LCD while locking.
  */
 static void printDoorLockingMessage(void) {
-	LCD_clearScreen();
-	LCD_displayString((const uint8*) "Door is");
-	LCD_displayStringRowColumn(LCD_ROW_1, 0, (const uint8*) "locking...");
+	LCD_frameClear();
+	LCD_frameCharacter(Glyph_get(GLYPH_LOCK));
+	LCD_frameStringRowColumn_P(LCD_ROW_0, 2, Message_get(MESSAGE_LOCKING));
+}
+/*
+ * Description :
+ * Draws a progress bar on the second row, one step per pixel column: filling
+ * over a_total_ms since the screen was shown, or emptying if a_countdown.
+ * Only the cell at the end of the bar changes between two redraws.
+ */
+static void printProgress(uint32 a_total_ms, boolean a_countdown) {
+	uint32 elapsed = SysTick_getMillis() - g_screen_start_ms;
+	uint8 steps;
+	if (elapsed > a_total_ms) {
+		elapsed = a_total_ms;
+	}
+	steps = (elapsed * PROGRESS_STEPS) / a_total_ms;
+	if (a_countdown) {
+		steps = PROGRESS_STEPS - steps;
+	}
+	LCD_frameMoveCursor(LCD_ROW_1, 0);
+	for (uint8 col = 0; col < LCD_MAX_COLS; col++) {
+		if (steps >= GLYPH_BAR_COLUMNS) {
+			LCD_frameCharacter(Glyph_get(GLYPH_BAR_5));
+			steps -= GLYPH_BAR_COLUMNS;
+		} else if (steps != 0) {
+			LCD_frameCharacter(Glyph_get(GLYPH_BAR_1 + steps - 1));
+			steps = 0;
+		} else {
+			LCD_frameCharacter(' ');
+		}
+	}
+}
+/*
+ * Description :
+ * Draws the progress bar of the current screen, if it has one.
+ */
+static void printScreenProgress(void) {
+	switch (g_screen) {
+	case SCREEN_DOOR_UNLOCKING:
+		printProgress(DOOR_UNLOCK_MS, FALSE);
+		break;
+	case SCREEN_DOOR_LOCKING:
+		printProgress(DOOR_LOCK_MS, FALSE);
+		break;
+	case SCREEN_ALARM:
+		printProgress(ALARM_MS, TRUE);
+		break;
+	default:
+		break;
+	}
 }
 
 /*
  * Description :
- * Allows the user to attempt the password until control ECU sends confirmation or
- * triggers alarm mode.
+ * Changes the screen, drawn later by the display task.
+ */
+static void showScreen(HMI_ScreenType a_screen) {
+	g_screen = a_screen;
+	g_screen_start_ms = SysTick_getMillis();
+	/* Screens with a progress bar are redrawn periodically */
+	if (a_screen == SCREEN_DOOR_UNLOCKING || a_screen == SCREEN_DOOR_LOCKING
+			|| a_screen == SCREEN_ALARM) {
+		Sched_setPeriod(TASK_DISPLAY, PROGRESS_PERIOD_MS);
+	} else {
+		Sched_setPeriod(TASK_DISPLAY, 0);
+	}
+	Sched_setEvent(TASK_DISPLAY, EVENT_REDRAW);
+}
+/*
+ * Description :
+ * Shows a password prompt and starts taking keys as password characters.
+ */
+static void startPasswordEntry(HMI_ScreenType a_screen) {
+	g_entry_index = 0;
+	g_entry_active = TRUE;
+	showScreen(a_screen);
+}
+/*
+ * Description :
+ * Waits for a reply from Control ECU, keys are ignored meanwhile.
+ */
+static void expectReply(HMI_ReplyType a_reply) {
+	g_reply = a_reply;
+	g_reply_index = 0;
+}
+/*
+ * Description :
+ * Enters a system mode received from Control ECU.
+ */
+static void enterMode(uint8 a_mode) {
+	HMI_status = a_mode;
+	switch (HMI_status) {
+	case MODE_FIRST_BOOT:
+		startPasswordEntry(SCREEN_FIRST_BOOT_1);
+		break;
+	case MODE_NORMAL_BOOT_LOCKED:
+		startPasswordEntry(SCREEN_LOCKED);
+		break;
+	case MODE_NORMAL_BOOT_MAIN:
+		showScreen(SCREEN_MAIN_MENU);
+		break;
+	case MODE_ALARM_MODE:
+		/* Wait for a notification from Control ECU to exit alarm mode */
+		showScreen(SCREEN_ALARM);
+		expectReply(REPLY_ALARM);
+		break;
+	}
+}
+/*
+ * Description :
+ * Handles a debounced key press.
+ * Password characters are sent with a SYNC to Control ECU once all are entered.
  *
  * UART_SENDS# = 2
- * UART_REC#   = 2
+ * UART_REC#   = 0
  */
-static void attemptPassword(uint8 *password_match) {
-	do {
-		/* Get and send password to CONTROL ECU */
-		printLockedMenu();
-		_delay_ms(300);
-		getSendPasswordSync();
+static void onKeyPressed(uint8 a_key) {
+	if (g_reply != REPLY_NONE) {
+		return;
+	}
+	if (g_entry_active) {
+		/* Adjust number to contain ASCII if its a number so that the number '0'
+		 * is not counted as a null terminator character,
+		 * if it's a symbol like '#','+','*'... then no need to adjust.
+		 * */
+		if (a_key < 10) {
+			a_key += '0';
+		}
+		g_password_buffer[g_entry_index++] = a_key;
+		Sched_setEvent(TASK_DISPLAY, EVENT_ECHO);
+		if (g_entry_index < PASSWORD_LENGTH - 2) {
+			return;
+		}
+		/* Send password after syncing with control */
+		g_entry_active = FALSE;
+		UART_sendByte(SYNC_HANDSHAKE);
+		UART_sendString(g_password_buffer);
+		if (g_screen == SCREEN_FIRST_BOOT_1) {
+			/* Get second password */
+			startPasswordEntry(SCREEN_FIRST_BOOT_2);
+		} else if (g_screen == SCREEN_FIRST_BOOT_2) {
+			expectReply(REPLY_FIRST_BOOT);
+		} else {
+			expectReply(REPLY_ATTEMPT);
+		}
+	} else if (g_screen == SCREEN_MAIN_MENU && (a_key == '+' || a_key == '-')) {
+		/* '+': open the door, '-': change password,
+		 * both request the old password first */
+		g_request = (a_key == '+') ? OPEN_DOOR_REQUEST : CHANGE_PASS_REQUEST;
+		UART_sendByte(SYNC_HANDSHAKE);
+		UART_sendByte(g_request);
+		startPasswordEntry(SCREEN_LOCKED);
+	}
+}
+/*
+ * Description :
+ * Handles one byte of the awaited reply from Control ECU.
+ */
+static void onByteReceived(uint8 a_byte) {
+	switch (g_reply) {
+	case REPLY_FIRST_BOOT:
+		if (g_reply_index == 0) {
+			/* SYNC UART */
+			if (a_byte == SYNC_HANDSHAKE) {
+				g_reply_index++;
+			}
+		} else {
+			g_reply = REPLY_NONE;
+			/* If passwords match, change mode to main menu mode */
+			enterMode(a_byte ? MODE_NORMAL_BOOT_MAIN : MODE_FIRST_BOOT);
+		}
+		break;
+	case REPLY_ATTEMPT:
+		if (g_reply_index == 0) {
+			g_password_match = a_byte;
+			g_reply_index++;
+		} else {
+			g_reply = REPLY_NONE;
+			if (g_password_match && g_request == OPEN_DOOR_REQUEST) {
+				/* Wait until Control ECU opens then closes the door */
+				HMI_status = a_byte;
+				showScreen(SCREEN_DOOR_UNLOCKING);
+				expectReply(REPLY_DOOR);
+			} else {
+				/* Another try, new password entry or alarm */
+				enterMode(a_byte);
+			}
+		}
+		break;
+	case REPLY_DOOR:
+		if (a_byte == SYNC_HANDSHAKE) {
+			if (g_reply_index == 0) {
+				showScreen(SCREEN_DOOR_LOCKING);
+				g_reply_index++;
+			} else {
+				g_reply = REPLY_NONE;
+				g_request = 0;
+				enterMode(HMI_status);
+			}
+		}
+		break;
+	case REPLY_ALARM:
+		if (g_reply_index == 0) {
+			if (a_byte == SYNC_HANDSHAKE) {
+				g_reply_index++;
+			}
+		} else {
+			g_reply = REPLY_NONE;
+			enterMode(a_byte);
+		}
+		break;
+	default:
+		/* Unsolicited bytes are dropped */
+		break;
+	}
+}
 
-		*password_match = UART_receiveByte();
-		/* Receive next status from CONTROL ECU */
-		HMI_status = UART_receiveByte();
-	} while (!(*password_match) && (HMI_status != MODE_ALARM_MODE));
+/*******************************************************************************
+ *                          Tasks & Callbacks Definitions      		           *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * UART receive interrupt callback, wakes the link task.
+ */
+void HMI_Rx_Callback(void) {
+	Sched_setEvent(TASK_LINK, EVENT_RX);
+}
+/*
+ * Description :
+ * Link task: handles every byte buffered by the UART.
+ */
+static void linkTask(uint8 a_events) {
+	uint8 byte;
+	while (UART_tryReceiveByte(&byte)) {
+		onByteReceived(byte);
+	}
+}
+/*
+ * Description :
+ * Keypad task: one scan per period. A key counts once it is stable for
+ * KEYPAD_DEBOUNCE_SCANS scans, and again only after being released.
+ */
+static void keypadTask(uint8 a_events) {
+	static uint8 last_key = KEYPAD_NO_KEY;
+	static uint8 stable_scans = 0;
+	uint8 key = KEYPAD_scan();
+	if (key != last_key) {
+		last_key = key;
+		stable_scans = 0;
+	} else if (stable_scans < KEYPAD_DEBOUNCE_SCANS) {
+		if (++stable_scans == KEYPAD_DEBOUNCE_SCANS && key != KEYPAD_NO_KEY) {
+			onKeyPressed(key);
+		}
+	}
+}
+/*
+ * Description :
+ * Display task: draws the current screen into the LCD frame buffer, then one
+ * '*' per password key, and its progress bar on every period.
+ */
+static void displayTask(uint8 a_events) {
+	static uint8 stars = 0; /* '*' shown for the current entry */
+	if (a_events & EVENT_REDRAW) {
+		switch (g_screen) {
+		case SCREEN_FIRST_BOOT_1:
+			printFirstBootMenu1();
+			break;
+		case SCREEN_FIRST_BOOT_2:
+			printFirstBootMenu2();
+			break;
+		case SCREEN_MAIN_MENU:
+			printMainMenu();
+			break;
+		case SCREEN_LOCKED:
+			printLockedMenu();
+			break;
+		case SCREEN_ALARM:
+			printAlarmMessage();
+			break;
+		case SCREEN_DOOR_UNLOCKING:
+			printDoorUnlockingMessage();
+			break;
+		case SCREEN_DOOR_LOCKING:
+			printDoorLockingMessage();
+			break;
+		}
+		stars = 0;
+	}
+	if (a_events & (EVENT_REDRAW | SCHED_EVENT_PERIOD)) {
+		printScreenProgress();
+	}
+	if (g_entry_active || g_reply != REPLY_NONE) {
+		while (stars < g_entry_index) {
+			LCD_frameCharacter('*');
+			stars++;
+		}
+	}
+	/* Only the cells that changed since the last screen are sent */
+	LCD_frameRefresh();
+}
 
+/*
+ * Description :
+ * Scheduler idle hook (tickless idle): sleeps until the next keypad scan or
+ * a byte from the Control ECU.
+ */
+static void idleHook(void) {
+	uint32 idle_ms = Sched_getIdleTime();
+	cli();
+	if (Sched_isIdle()) {
+		SysTick_sleepFor(idle_ms);
+	} else {
+		sei();
+	}
 }
 
 int main(void) {
@@ -150,8 +481,6 @@ int main(void) {
 	/* Initialize element before last element in buffer with UART end of string character: '#'
 	 *  for UART receive string function to work correctly*/
 	g_password_buffer[PASSWORD_LENGTH - 2] = UART_EOS;
-	boolean password_match = FALSE;
-	uint8 keyPressed;
 	/* Modules configurations */
 
 	/*
@@ -164,94 +493,21 @@ int main(void) {
 	UART_ConfigType conf = {9600,{0,PARITY_DISABLED,UART_CH_SIZE_8}};
 
 	/* Modules initialization */
+	Profiler_init();
 	UART_init(&conf);
 	LCD_init();
-	/*Super loop*/
-	for (;;) {
-		switch (HMI_status) {
-
-		/************************** First boot, setting up new password  **************************/
-		case MODE_FIRST_BOOT:
-			/* Get first password  */
-			printFirstBootMenu1();
-			getSendPasswordSync();
-			/* Get second password */
-			printFirstBootMenu2();
-			getSendPasswordSync();
-			/* SYNC UART */
-			while (UART_receiveByte() != SYNC_HANDSHAKE) {
-			}
-			password_match = UART_receiveByte();
-			/* If passwords match, change mode to main menu mode */
-			if (password_match) {
-				password_match = FALSE;
-				HMI_status = MODE_NORMAL_BOOT_MAIN;
-			}
-			break;
-		case MODE_NORMAL_BOOT_LOCKED:
-			/*********************** Mode for password attempts by the user ***********************/
-			attemptPassword(&password_match);
-			break;
-		case MODE_NORMAL_BOOT_MAIN:
-			printMainMenu();
-			/* Await +/- to be pressed by user */
-			do {
-				keyPressed = KEYPAD_getPressedKey();
-			} while (keyPressed != '+' && keyPressed != '-');
-
-			/* Delay to avoid de-bounce that triggers a wrong keystroke when attempting password*/
-			_delay_ms(400);
-
-			/* User wants to open the door (pressed '+' key),
-			 * request old password first*/
-			if (keyPressed == '+') {
-				/* Send open door request to Control ECU and attempt password entry*/
-				UART_sendByte(SYNC_HANDSHAKE);
-				/* Send request to Control ECU to open the door */
-				UART_sendByte(OPEN_DOOR_REQUEST);
-				/* Allow user to attempt the password before proceeding */
-				attemptPassword(&password_match);
-				/* Password attempt was successful */
-
-				if (HMI_status != MODE_ALARM_MODE) {
-					printDoorUnlockingMessage();
-					/* Wait until Control ECU opens the door */
-					while (UART_receiveByte() != SYNC_HANDSHAKE)
-						;
-					printDoorLockingMessage();
-					/* Wait until Control ECU closes the door */
-					while (UART_receiveByte() != SYNC_HANDSHAKE)
-						;
-					/* Password attempt was unsuccessful */
-				} else {
-					/* Skip over to alarm mode*/
-				}
-				/* Reset key press to receive new press */
-				keyPressed = 0;
-
-			}
-
-			/* User wants to change password (pressed '-' key,
-			 * request old password first*/
-			else {
-				UART_sendByte(SYNC_HANDSHAKE);
-				/* Send request to Control ECU to change the password */
-				UART_sendByte(CHANGE_PASS_REQUEST);
-				/* Allow user to attempt the password before proceeding */
-				attemptPassword(&password_match);
-
-				/* Reset key press to receive new press */
-				keyPressed = 0;
-			}
-			break;
-			/******** Alarm mode triggered by wrong password entry, displays error message ********/
-		case MODE_ALARM_MODE:
-			printAlarmMessage();
-			/* Wait for a notification from Control ECU to exit alarm mode */
-			while (UART_receiveByte() != SYNC_HANDSHAKE)
-				;
-			HMI_status = UART_receiveByte();
-			break;
-		}
-	}
+	Glyph_init();
+	SysTick_init();
+	/* Tasks */
+	Sched_init();
+	Sched_addTask(TASK_LINK, linkTask, 0);
+	Sched_addTask(TASK_KEYPAD, keypadTask, KEYPAD_SCAN_PERIOD_MS);
+	Sched_addTask(TASK_DISPLAY, displayTask, 0);
+	Sched_setIdleCallback(idleHook);
+	UART_setRXCallback_Notif(HMI_Rx_Callback);
+	/* First boot, setting up new password */
+	enterMode(MODE_FIRST_BOOT);
+	/* Enable global interrupts */
+	sei();
+	Sched_start();
 }
@@ -0,0 +1,23 @@
+/******************************************************************************
+ *
+ * Module: GPIO - Host simulation
+ *
+ * File Name: cpufunc.h
+ *
+ * Description: Host replacement of <avr/cpufunc.h>, _NOP takes one CPU cycle
+ * 				of virtual time.
+ *
+ * Date Created: 18/10/2026
+ *
+ * Author: Hazem Montasser
+ *
+ *******************************************************************************/
+
+#ifndef GPIO_SIM_AVR_CPUFUNC_H_
+#define GPIO_SIM_AVR_CPUFUNC_H_
+
+#include "gpio_sim.h"
+
+#define _NOP() 	GPIO_SIM_advanceTimeNs(GPIO_SIM_CYCLE_NS)
+
+#endif /* GPIO_SIM_AVR_CPUFUNC_H_ */
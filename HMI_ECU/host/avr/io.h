@@ -0,0 +1,36 @@
+/******************************************************************************
+ *
+ * Module: GPIO - Host simulation
+ *
+ * File Name: io.h
+ *
+ * Description: Host replacement of <avr/io.h> for the GPIO simulation, the
+ * 				port registers are plain variables owned by gpio_sim.c.
+ * 				Only the registers used by the GPIO drivers are provided.
+ *
+ * Date Created: 18/10/2026
+ *
+ * Author: Hazem Montasser
+ *
+ *******************************************************************************/
+
+#ifndef GPIO_SIM_AVR_IO_H_
+#define GPIO_SIM_AVR_IO_H_
+
+/* [port][register]: PINx, DDRx, PORTx of ports A..D */
+extern volatile unsigned char GPIO_SIM_registers[4][3];
+
+#define PINA 	(GPIO_SIM_registers[0][0])
+#define DDRA 	(GPIO_SIM_registers[0][1])
+#define PORTA 	(GPIO_SIM_registers[0][2])
+#define PINB 	(GPIO_SIM_registers[1][0])
+#define DDRB 	(GPIO_SIM_registers[1][1])
+#define PORTB 	(GPIO_SIM_registers[1][2])
+#define PINC 	(GPIO_SIM_registers[2][0])
+#define DDRC 	(GPIO_SIM_registers[2][1])
+#define PORTC 	(GPIO_SIM_registers[2][2])
+#define PIND 	(GPIO_SIM_registers[3][0])
+#define DDRD 	(GPIO_SIM_registers[3][1])
+#define PORTD 	(GPIO_SIM_registers[3][2])
+
+#endif /* GPIO_SIM_AVR_IO_H_ */
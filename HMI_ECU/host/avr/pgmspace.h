@@ -0,0 +1,24 @@
+/******************************************************************************
+ *
+ * Module: GPIO - Host simulation
+ *
+ * File Name: pgmspace.h
+ *
+ * Description: Host replacement of <avr/pgmspace.h>, program memory is
+ * 				ordinary read-only memory on the host.
+ *
+ * Date Created: 18/10/2026
+ *
+ * Author: Hazem Montasser
+ *
+ *******************************************************************************/
+
+#ifndef GPIO_SIM_AVR_PGMSPACE_H_
+#define GPIO_SIM_AVR_PGMSPACE_H_
+
+#define PROGMEM
+#define PSTR(s) 				(s)
+#define pgm_read_byte(addr) 	(*(const unsigned char*) (addr))
+#define pgm_read_ptr(addr) 		(*(const void* const*) (addr))
+
+#endif /* GPIO_SIM_AVR_PGMSPACE_H_ */
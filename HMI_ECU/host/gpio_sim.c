@@ -0,0 +1,509 @@
+/******************************************************************************
+ *
+ * Module: GPIO - Host simulation
+ *
+ * File Name: gpio_sim.c
+ *
+ * Description: Source file for the host (Linux) implementation of the GPIO
+ * 				driver API with VCD waveform capture.
+ *
+ * Date Created: 18/10/2026
+ *
+ * Author: Hazem Montasser
+ *
+ *******************************************************************************/
+
+#include "gpio.h"
+#include "gpio_sim.h"
+#include "systick.h"	/* For the external interrupt events time */
+#include <stdio.h>
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/* Register index inside GPIO_SIM_registers[port] */
+#define SIM_REG_PIN 		(0U)
+#define SIM_REG_DDR 		(1U)
+#define SIM_REG_PORT 		(2U)
+
+/* VCD signals of a port: one wire per pin then the DDR vector */
+#define SIM_SIGNALS_PER_PORT 	(NUM_OF_PINS_PER_PORT + 1U)
+#define SIM_NO_TIME 			(~0ULL)
+
+/*******************************************************************************
+ *                               Types Declaration                             *
+ *******************************************************************************/
+
+typedef struct {
+	uint8 PortA;
+	uint8 PinA;
+	uint8 PortB;
+	uint8 PinB;
+} GPIO_SIM_SwitchType;
+
+/*******************************************************************************
+ *                         Global Variables(Private)                           *
+ *******************************************************************************/
+
+volatile unsigned char GPIO_SIM_registers[NUM_OF_PORTS][3];
+
+static FILE *g_vcd = NULL_PTR;
+static uint64 g_now_ns = 0;
+static uint64 g_dumped_ns = SIM_NO_TIME; /* Last timestamp written to the VCD */
+static uint8 g_access_cycles = GPIO_SIM_ACCESS_CYCLES;
+static uint8 g_drive_mask[NUM_OF_PORTS]; /* Inputs driven from outside */
+static uint8 g_drive_level[NUM_OF_PORTS]; /* Level of the driven inputs */
+static GPIO_SIM_SwitchType g_switches[GPIO_SIM_MAX_SWITCHES];
+static uint8 g_switch_count = 0;
+static char g_levels[NUM_OF_PORTS][NUM_OF_PINS_PER_PORT]; /* '0', '1' or 'z' */
+static uint8 g_ddr_dumped[NUM_OF_PORTS];
+static GPIO_SIM_StatsType g_stats;
+
+/* External interrupts, same behavior as gpio.c */
+static const uint8 g_extIntPins[GPIO_EXT_INT_COUNT][2] = {
+		{ GPIO_INT0_PORT_ID, GPIO_INT0_PIN_ID },
+		{ GPIO_INT1_PORT_ID, GPIO_INT1_PIN_ID },
+		{ GPIO_INT2_PORT_ID, GPIO_INT2_PIN_ID } };
+static GPIO_ExtIntConfigType g_extInts[GPIO_EXT_INT_COUNT];
+static boolean g_extIntEnabled[GPIO_EXT_INT_COUNT];
+static void (*g_extIntCallbacks[GPIO_EXT_INT_COUNT])(void);
+static uint32 g_last_event_ms[GPIO_EXT_INT_COUNT];
+static boolean g_event_seen[GPIO_EXT_INT_COUNT];
+static GPIO_EventType g_events[GPIO_EVENT_QUEUE_SIZE];
+static uint8 g_event_head = 0;
+static uint8 g_event_tail = 0;
+static uint8 g_event_overflows = 0;
+
+/*******************************************************************************
+ *                      Functions Definitions (Private)                        *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Level of a pin on its own: output level, external drive or pull-up.
+ */
+static char sim_ownLevel(uint8 a_port, uint8 a_pin) {
+	if (BIT_IS_SET(GPIO_SIM_registers[a_port][SIM_REG_DDR], a_pin)) {
+		return BIT_IS_SET(GPIO_SIM_registers[a_port][SIM_REG_PORT], a_pin) ?
+				'1' : '0';
+	}
+	if (BIT_IS_SET(g_drive_mask[a_port], a_pin)) {
+		return BIT_IS_SET(g_drive_level[a_port], a_pin) ? '1' : '0';
+	}
+	if (BIT_IS_SET(GPIO_SIM_registers[a_port][SIM_REG_PORT], a_pin)) {
+		return '1';
+	}
+	return 'z';
+}
+
+/*
+ * Description :
+ * Level seen on a pin: an output connected through a closed switch wins over
+ * the pin's own drive or pull-up, then any driven or pulled-up pin it is
+ * connected to.
+ */
+static char sim_level(uint8 a_port, uint8 a_pin) {
+	char level = sim_ownLevel(a_port, a_pin);
+	char other;
+	uint8 port;
+	uint8 pin;
+
+	if (BIT_IS_SET(GPIO_SIM_registers[a_port][SIM_REG_DDR], a_pin)) {
+		return level;
+	}
+	for (uint8 i = 0; i < g_switch_count; i++) {
+		if (g_switches[i].PortA == a_port && g_switches[i].PinA == a_pin) {
+			port = g_switches[i].PortB;
+			pin = g_switches[i].PinB;
+		} else if (g_switches[i].PortB == a_port
+				&& g_switches[i].PinB == a_pin) {
+			port = g_switches[i].PortA;
+			pin = g_switches[i].PinA;
+		} else {
+			continue;
+		}
+		other = sim_ownLevel(port, pin);
+		if (BIT_IS_SET(GPIO_SIM_registers[port][SIM_REG_DDR], pin)) {
+			return other;
+		}
+		if (level == 'z') {
+			level = other;
+		}
+	}
+	return level;
+}
+
+/*
+ * Description :
+ * Queues a debounced external interrupt event and calls the line callback.
+ */
+static void sim_extIntEvent(GPIO_ExtIntType a_line, uint8 a_level) {
+	uint32 now = SysTick_getMillis();
+	GPIO_EventType *event;
+
+	if (g_event_seen[a_line]
+			&& (uint32) (now - g_last_event_ms[a_line])
+					< g_extInts[a_line].Debounce_ms) {
+		return;
+	}
+	g_event_seen[a_line] = TRUE;
+	g_last_event_ms[a_line] = now;
+	if ((uint8) (g_event_head - g_event_tail) < GPIO_EVENT_QUEUE_SIZE) {
+		event = &g_events[g_event_head & (GPIO_EVENT_QUEUE_SIZE - 1)];
+		event->Line = a_line;
+		event->Level = a_level;
+		event->Time_ms = now;
+		g_event_head++;
+	} else if (g_event_overflows != 0xFF) {
+		g_event_overflows++;
+	}
+	if (g_extIntCallbacks[a_line] != NULL_PTR) {
+		(*g_extIntCallbacks[a_line])();
+	}
+}
+
+/*
+ * Description :
+ * Checks an enabled external interrupt line against its sense after its pin
+ * changed from a_old to a_new.
+ */
+static void sim_extIntSense(GPIO_ExtIntType a_line, uint8 a_old, uint8 a_new) {
+	boolean fire = FALSE;
+	switch (g_extInts[a_line].Sense) {
+	case GPIO_SENSE_LOW_LEVEL:
+		fire = (a_new == LOGIC_LOW);
+		break;
+	case GPIO_SENSE_ANY_EDGE:
+		fire = TRUE;
+		break;
+	case GPIO_SENSE_FALLING:
+		fire = (a_new == LOGIC_LOW);
+		break;
+	case GPIO_SENSE_RISING:
+		fire = (a_new == LOGIC_HIGH);
+		break;
+	}
+	if (fire && a_old != a_new) {
+		sim_extIntEvent(a_line, a_new);
+	}
+}
+
+/*
+ * Description :
+ * Resolves every pin after a register or wiring change: updates the PIN
+ * registers, dumps the changed signals and senses the external interrupts.
+ */
+static void sim_update(void) {
+	char level;
+	uint8 pins;
+	boolean stamped = FALSE;
+	uint8 old_level[GPIO_EXT_INT_COUNT];
+
+	for (uint8 line = 0; line < GPIO_EXT_INT_COUNT; line++) {
+		old_level[line] = g_levels[g_extIntPins[line][0]][g_extIntPins[line][1]]
+				== '1' ? LOGIC_HIGH : LOGIC_LOW;
+	}
+	for (uint8 port = 0; port < NUM_OF_PORTS; port++) {
+		pins = 0;
+		for (uint8 pin = 0; pin < NUM_OF_PINS_PER_PORT; pin++) {
+			level = sim_level(port, pin);
+			if (level == '1') {
+				pins |= (1 << pin);
+			}
+			if (level == g_levels[port][pin]) {
+				continue;
+			}
+			g_stats.transitions++;
+			g_levels[port][pin] = level;
+			if (g_vcd != NULL_PTR) {
+				if (!stamped && g_dumped_ns != g_now_ns) {
+					fprintf(g_vcd, "#%llu\n", (unsigned long long) g_now_ns);
+					g_dumped_ns = g_now_ns;
+				}
+				stamped = TRUE;
+				fprintf(g_vcd, "%c%c\n", level,
+						'!' + port * SIM_SIGNALS_PER_PORT + pin);
+			}
+		}
+		GPIO_SIM_registers[port][SIM_REG_PIN] = pins;
+		if (GPIO_SIM_registers[port][SIM_REG_DDR] != g_ddr_dumped[port]) {
+			g_ddr_dumped[port] = GPIO_SIM_registers[port][SIM_REG_DDR];
+			if (g_vcd != NULL_PTR) {
+				if (!stamped && g_dumped_ns != g_now_ns) {
+					fprintf(g_vcd, "#%llu\n", (unsigned long long) g_now_ns);
+					g_dumped_ns = g_now_ns;
+				}
+				stamped = TRUE;
+				fputc('b', g_vcd);
+				for (sint8 bit = NUM_OF_PINS_PER_PORT - 1; bit >= 0; bit--) {
+					fputc(BIT_IS_SET(g_ddr_dumped[port], bit) ? '1' : '0',
+							g_vcd);
+				}
+				fprintf(g_vcd, " %c\n",
+						'!' + port * SIM_SIGNALS_PER_PORT
+								+ NUM_OF_PINS_PER_PORT);
+			}
+		}
+	}
+	for (uint8 line = 0; line < GPIO_EXT_INT_COUNT; line++) {
+		if (g_extIntEnabled[line]) {
+			sim_extIntSense(line, old_level[line],
+					g_levels[g_extIntPins[line][0]][g_extIntPins[line][1]]
+							== '1' ? LOGIC_HIGH : LOGIC_LOW);
+		}
+	}
+}
+
+/*
+ * Description :
+ * Charges the time of one GPIO access to the virtual clock.
+ */
+static void sim_access(boolean a_write) {
+	uint64 ns = (uint64) g_access_cycles * GPIO_SIM_CYCLE_NS;
+	g_now_ns += ns;
+	g_stats.access_time_ns += ns;
+	if (a_write) {
+		g_stats.writes++;
+	} else {
+		g_stats.reads++;
+	}
+}
+
+/*******************************************************************************
+ *                      Functions Definitions (gpio.h API)                     *
+ *******************************************************************************/
+
+void GPIO_setupPinDirection(uint8 port_num, uint8 pin_num,
+		GPIO_PinDirectionType direction) {
+	if ((pin_num >= NUM_OF_PINS_PER_PORT) || (port_num >= NUM_OF_PORTS)) {
+		return;
+	}
+	sim_access(TRUE);
+	if (direction == PIN_OUTPUT) {
+		SET_BIT(GPIO_SIM_registers[port_num][SIM_REG_DDR], pin_num);
+	} else {
+		CLEAR_BIT(GPIO_SIM_registers[port_num][SIM_REG_DDR], pin_num);
+	}
+	sim_update();
+}
+
+void GPIO_writePin(uint8 port_num, uint8 pin_num, uint8 value) {
+	if ((pin_num >= NUM_OF_PINS_PER_PORT) || (port_num >= NUM_OF_PORTS)) {
+		return;
+	}
+	sim_access(TRUE);
+	if (value == LOGIC_HIGH) {
+		SET_BIT(GPIO_SIM_registers[port_num][SIM_REG_PORT], pin_num);
+	} else if (value == LOGIC_LOW) {
+		CLEAR_BIT(GPIO_SIM_registers[port_num][SIM_REG_PORT], pin_num);
+	}
+	sim_update();
+}
+
+uint8 GPIO_readPin(uint8 port_num, uint8 pin_num) {
+	if ((pin_num >= NUM_OF_PINS_PER_PORT) || (port_num >= NUM_OF_PORTS)) {
+		return LOGIC_LOW;
+	}
+	sim_access(FALSE);
+	return BIT_IS_SET(GPIO_SIM_registers[port_num][SIM_REG_PIN], pin_num) ?
+			LOGIC_HIGH : LOGIC_LOW;
+}
+
+void GPIO_setupPortDirection(uint8 port_num, uint8 direction) {
+	if (port_num >= NUM_OF_PORTS) {
+		return;
+	}
+	sim_access(TRUE);
+	GPIO_SIM_registers[port_num][SIM_REG_DDR] = direction;
+	sim_update();
+}
+
+void GPIO_writePort(uint8 port_num, uint8 value) {
+	if (port_num >= NUM_OF_PORTS) {
+		return;
+	}
+	sim_access(TRUE);
+	GPIO_SIM_registers[port_num][SIM_REG_PORT] = value;
+	sim_update();
+}
+
+uint8 GPIO_readPort(uint8 port_num) {
+	if (port_num >= NUM_OF_PORTS) {
+		return 0x00;
+	}
+	sim_access(FALSE);
+	return GPIO_SIM_registers[port_num][SIM_REG_PIN];
+}
+
+boolean GPIO_setupExtInt(const GPIO_ExtIntConfigType *config_ptr) {
+	GPIO_ExtIntType line = config_ptr->Line;
+	if ((line >= GPIO_EXT_INT_COUNT)
+			|| ((line == GPIO_INT2) && (config_ptr->Sense < GPIO_SENSE_FALLING))) {
+		return FALSE;
+	}
+	g_extIntEnabled[line] = FALSE;
+	g_extInts[line] = *config_ptr;
+	g_event_seen[line] = FALSE;
+	GPIO_setupPinDirection(g_extIntPins[line][0], g_extIntPins[line][1],
+			PIN_INPUT);
+	GPIO_writePin(g_extIntPins[line][0], g_extIntPins[line][1],
+			config_ptr->PullUp ? LOGIC_HIGH : LOGIC_LOW);
+	g_extIntEnabled[line] = TRUE;
+	return TRUE;
+}
+
+void GPIO_disableExtInt(GPIO_ExtIntType line) {
+	if (line < GPIO_EXT_INT_COUNT) {
+		g_extIntEnabled[line] = FALSE;
+	}
+}
+
+void GPIO_setExtIntCallback(GPIO_ExtIntType line, void (*a_ptrToCallback)(void)) {
+	if (line < GPIO_EXT_INT_COUNT) {
+		g_extIntCallbacks[line] = a_ptrToCallback;
+	}
+}
+
+boolean GPIO_getEvent(GPIO_EventType *event_ptr) {
+	if (g_event_tail == g_event_head) {
+		return FALSE;
+	}
+	*event_ptr = g_events[g_event_tail & (GPIO_EVENT_QUEUE_SIZE - 1)];
+	g_event_tail++;
+	return TRUE;
+}
+
+uint8 GPIO_getEventOverflows(void) {
+	return g_event_overflows;
+}
+
+/*******************************************************************************
+ *                      Functions Definitions (Simulator)                      *
+ *******************************************************************************/
+
+uint8 GPIO_SIM_open(const char *a_vcdPath) {
+	static const char port_names[NUM_OF_PORTS] = { 'A', 'B', 'C', 'D' };
+
+	GPIO_SIM_close();
+	for (uint8 port = 0; port < NUM_OF_PORTS; port++) {
+		for (uint8 reg = 0; reg < 3; reg++) {
+			GPIO_SIM_registers[port][reg] = 0;
+		}
+		g_drive_mask[port] = 0;
+		g_drive_level[port] = 0;
+		g_ddr_dumped[port] = 0;
+		for (uint8 pin = 0; pin < NUM_OF_PINS_PER_PORT; pin++) {
+			g_levels[port][pin] = 'z';
+		}
+	}
+	for (uint8 line = 0; line < GPIO_EXT_INT_COUNT; line++) {
+		g_extIntEnabled[line] = FALSE;
+	}
+	g_switch_count = 0;
+	g_now_ns = 0;
+	g_dumped_ns = SIM_NO_TIME;
+	GPIO_SIM_resetStats();
+
+	if (a_vcdPath == NULL_PTR) {
+		return TRUE;
+	}
+	g_vcd = fopen(a_vcdPath, "w");
+	if (g_vcd == NULL_PTR) {
+		return FALSE;
+	}
+	fprintf(g_vcd, "$timescale 1ns $end\n$scope module gpio $end\n");
+	for (uint8 port = 0; port < NUM_OF_PORTS; port++) {
+		for (uint8 pin = 0; pin < NUM_OF_PINS_PER_PORT; pin++) {
+			fprintf(g_vcd, "$var wire 1 %c P%c%u $end\n",
+					'!' + port * SIM_SIGNALS_PER_PORT + pin, port_names[port],
+					pin);
+		}
+		fprintf(g_vcd, "$var wire 8 %c DDR%c $end\n",
+				'!' + port * SIM_SIGNALS_PER_PORT + NUM_OF_PINS_PER_PORT,
+				port_names[port]);
+	}
+	fprintf(g_vcd, "$upscope $end\n$enddefinitions $end\n#0\n$dumpvars\n");
+	for (uint8 port = 0; port < NUM_OF_PORTS; port++) {
+		for (uint8 pin = 0; pin < NUM_OF_PINS_PER_PORT; pin++) {
+			fprintf(g_vcd, "z%c\n", '!' + port * SIM_SIGNALS_PER_PORT + pin);
+		}
+		fprintf(g_vcd, "b00000000 %c\n",
+				'!' + port * SIM_SIGNALS_PER_PORT + NUM_OF_PINS_PER_PORT);
+	}
+	fprintf(g_vcd, "$end\n");
+	g_dumped_ns = 0;
+	return TRUE;
+}
+
+void GPIO_SIM_close(void) {
+	if (g_vcd != NULL_PTR) {
+		if (g_dumped_ns != g_now_ns) {
+			fprintf(g_vcd, "#%llu\n", (unsigned long long) g_now_ns);
+		}
+		fclose(g_vcd);
+		g_vcd = NULL_PTR;
+	}
+}
+
+void GPIO_SIM_advanceTimeNs(uint64 a_ns) {
+	g_now_ns += a_ns;
+	g_stats.delay_time_ns += a_ns;
+}
+
+uint64 GPIO_SIM_getTimeNs(void) {
+	return g_now_ns;
+}
+
+void GPIO_SIM_setAccessCycles(uint8 a_cycles) {
+	g_access_cycles = a_cycles;
+}
+
+void GPIO_SIM_driveInput(uint8 a_port, uint8 a_pin, uint8 a_level) {
+	if ((a_pin >= NUM_OF_PINS_PER_PORT) || (a_port >= NUM_OF_PORTS)) {
+		return;
+	}
+	SET_BIT(g_drive_mask[a_port], a_pin);
+	if (a_level == LOGIC_HIGH) {
+		SET_BIT(g_drive_level[a_port], a_pin);
+	} else {
+		CLEAR_BIT(g_drive_level[a_port], a_pin);
+	}
+	sim_update();
+}
+
+void GPIO_SIM_releaseInput(uint8 a_port, uint8 a_pin) {
+	if ((a_pin >= NUM_OF_PINS_PER_PORT) || (a_port >= NUM_OF_PORTS)) {
+		return;
+	}
+	CLEAR_BIT(g_drive_mask[a_port], a_pin);
+	sim_update();
+}
+
+uint8 GPIO_SIM_connect(uint8 a_portA, uint8 a_pinA, uint8 a_portB,
+		uint8 a_pinB) {
+	if (g_switch_count >= GPIO_SIM_MAX_SWITCHES) {
+		return FALSE;
+	}
+	g_switches[g_switch_count].PortA = a_portA;
+	g_switches[g_switch_count].PinA = a_pinA;
+	g_switches[g_switch_count].PortB = a_portB;
+	g_switches[g_switch_count].PinB = a_pinB;
+	g_switch_count++;
+	sim_update();
+	return TRUE;
+}
+
+void GPIO_SIM_disconnectAll(void) {
+	g_switch_count = 0;
+	sim_update();
+}
+
+void GPIO_SIM_getStats(GPIO_SIM_StatsType *a_stats) {
+	*a_stats = g_stats;
+}
+
+void GPIO_SIM_resetStats(void) {
+	GPIO_SIM_StatsType zero = { 0 };
+	g_stats = zero;
+}
@@ -0,0 +1,170 @@
+/******************************************************************************
+ *
+ * Module: GPIO - Host simulation
+ *
+ * File Name: gpio_sim.h
+ *
+ * Description: Header file for the host (Linux) implementation of the GPIO
+ * 				driver API which records every pin transition as a VCD waveform.
+ *
+ * 				gpio_sim.c provides every function of gpio.h. With GPIO_SIM
+ * 				defined, gpio.h routes the compile-time accessors to that API
+ * 				and host/ provides <avr/io.h>, <util/delay.h>, <util/atomic.h>
+ * 				and <avr/cpufunc.h>, so the target drivers build unchanged, e.g:
+ *
+ * 				HMI_ECU:
+ * 				gcc -DGPIO_SIM -DF_CPU=8000000UL -I. -Ihost lcd.c keypad.c timeout.c
+ * 					host/gpio_sim.c host/gpio_timing.c
+ * 				CONTROL_ECU:
+ * 				gcc -DGPIO_SIM -DF_CPU=8000000UL -I. -I../HMI_ECU/host dc_motor.c
+ * 					buzzer.c ../HMI_ECU/host/gpio_sim.c bench.c
+ *
+ * 				The simulation keeps a virtual clock, advanced by the busy waits
+ * 				(_delay_us/_delay_ms run in zero real time) and by every GPIO
+ * 				access (GPIO_SIM_ACCESS_CYCLES, the cost of the inlined SBI/CBI/
+ * 				OUT/SBIC on target). Each pin is dumped as a wire of its level,
+ * 				'z' for a floating input, and each DDR as an 8-bit vector.
+ *
+ * 				Inputs are resolved as on the device: outputs drive their PORT
+ * 				bit, an input reads the output it is connected to (a closed
+ * 				switch, e.g. a pressed key), else its external drive, else its
+ * 				pull-up. A floating input reads LOGIC_LOW.
+ *
+ * 				External interrupts sense edges of the resolved levels, the
+ * 				bench provides SysTick_getMillis for the debounce and events.
+ *
+ * Date Created: 18/10/2026
+ *
+ * Author: Hazem Montasser
+ *
+ *******************************************************************************/
+
+#ifndef GPIO_SIM_H_
+#define GPIO_SIM_H_
+
+#include "std_types.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define GPIO_SIM_CYCLE_NS 			(1000000000ULL / (F_CPU))	/* One CPU cycle */
+#define GPIO_SIM_ACCESS_CYCLES 		(2U)	/* Default cycles per GPIO access */
+#define GPIO_SIM_MAX_SWITCHES 		(8U)	/* Pin to pin connections closed at once */
+
+/*******************************************************************************
+ *                               Types Declaration                             *
+ *******************************************************************************/
+
+/******************************************************************************
+ *
+ * Structure Name: GPIO_SIM_StatsType
+ *
+ * Structure Description: Counters accumulated since GPIO_SIM_open() or the
+ * 		last GPIO_SIM_resetStats().
+ *
+ *******************************************************************************/
+typedef struct {
+	uint64 access_time_ns; /* Time spent in GPIO accesses */
+	uint64 delay_time_ns; /* Time spent in busy waits */
+	uint32 reads; /* Pin and port reads */
+	uint32 writes; /* Pin, port and direction writes */
+	uint32 transitions; /* Pin level changes */
+} GPIO_SIM_StatsType;
+
+/*******************************************************************************
+ *                              Functions Prototypes                           *
+ *******************************************************************************/
+
+/******************************************************************************
+ *
+ * Function Name: GPIO_SIM_open
+ *
+ * Description: Resets every port to its reset state (all inputs, no pull-ups),
+ * 		the virtual clock to 0 and starts the waveform file.
+ *
+ * Args:
+ *
+ * 		[in] const char *a_vcdPath
+ * 			VCD file to write, NULL_PTR for no waveform.
+ * 		[out] N/A
+ * Returns: uint8 (TRUE/FALSE)
+ * 		FALSE if the file could not be created.
+ *
+ *******************************************************************************/
+uint8 GPIO_SIM_open(const char *a_vcdPath);
+
+/******************************************************************************
+ *
+ * Function Name: GPIO_SIM_close
+ *
+ * Description: Writes the final timestamp and closes the waveform file.
+ *
+ *******************************************************************************/
+void GPIO_SIM_close(void);
+
+/******************************************************************************
+ *
+ * Function Name: GPIO_SIM_advanceTimeNs / GPIO_SIM_getTimeNs
+ *
+ * Description: Advances / returns the virtual clock.
+ *
+ *******************************************************************************/
+void GPIO_SIM_advanceTimeNs(uint64 a_ns);
+uint64 GPIO_SIM_getTimeNs(void);
+
+/******************************************************************************
+ *
+ * Function Name: GPIO_SIM_setAccessCycles
+ *
+ * Description: Sets the CPU cycles charged for every GPIO access, e.g. more to
+ * 		model the runtime API instead of the inlined accessors.
+ *
+ *******************************************************************************/
+void GPIO_SIM_setAccessCycles(uint8 a_cycles);
+
+/******************************************************************************
+ *
+ * Function Name: GPIO_SIM_driveInput / GPIO_SIM_releaseInput
+ *
+ * Description: Drives an input pin from outside to a level / stops driving it.
+ *
+ * Args:
+ *
+ * 		[in] uint8 a_port
+ * 			 uint8 a_pin
+ * 			 uint8 a_level
+ * 			LOGIC_HIGH/LOGIC_LOW.
+ * 		[out] N/A
+ * Returns: void
+ *
+ *******************************************************************************/
+void GPIO_SIM_driveInput(uint8 a_port, uint8 a_pin, uint8 a_level);
+void GPIO_SIM_releaseInput(uint8 a_port, uint8 a_pin);
+
+/******************************************************************************
+ *
+ * Function Name: GPIO_SIM_connect / GPIO_SIM_disconnectAll
+ *
+ * Description: Closes a switch between two pins (e.g. the row and column of a
+ * 		pressed key) / opens every switch.
+ *
+ * Returns: uint8 (TRUE/FALSE)
+ * 		FALSE if GPIO_SIM_MAX_SWITCHES switches are already closed.
+ *
+ *******************************************************************************/
+uint8 GPIO_SIM_connect(uint8 a_portA, uint8 a_pinA, uint8 a_portB,
+		uint8 a_pinB);
+void GPIO_SIM_disconnectAll(void);
+
+/******************************************************************************
+ *
+ * Function Name: GPIO_SIM_getStats / GPIO_SIM_resetStats
+ *
+ * Description: Copies / clears the simulation counters.
+ *
+ *******************************************************************************/
+void GPIO_SIM_getStats(GPIO_SIM_StatsType *a_stats);
+void GPIO_SIM_resetStats(void);
+
+#endif /* GPIO_SIM_H_ */
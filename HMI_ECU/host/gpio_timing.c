@@ -0,0 +1,121 @@
+/******************************************************************************
+ *
+ * Module: GPIO - Host simulation
+ *
+ * File Name: gpio_timing.c
+ *
+ * Description: Host bench measuring the virtual time of the LCD and keypad
+ * 				drivers on the simulated GPIO and writing their waveform.
+ *
+ * 				gcc -DGPIO_SIM -DF_CPU=8000000UL -I. -Ihost lcd.c keypad.c
+ * 					timeout.c host/gpio_sim.c host/gpio_timing.c
+ * 				./a.out [file.vcd]
+ *
+ * 				Add -DLCD_MODE=4 to measure the 4 bit bus mode.
+ *
+ * Date Created: 18/10/2026
+ *
+ * Author: Hazem Montasser
+ *
+ *******************************************************************************/
+
+#include "gpio.h"
+#include "gpio_sim.h"
+#include "lcd.h"
+#include "keypad.h"
+#include "systick.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+/*******************************************************************************
+ *                      Functions Definitions (Target shims)                   *
+ *******************************************************************************/
+
+/* The system tick follows the virtual clock */
+uint32 SysTick_getMillis(void) {
+	return (uint32) (GPIO_SIM_getTimeNs() / 1000000ULL);
+}
+
+/* avr-libc extension used by LCD_integerToString, declared in host/stdlib.h */
+char* itoa(int a_value, char *a_str, int a_radix) {
+	(void) a_radix;
+	sprintf(a_str, "%d", a_value);
+	return a_str;
+}
+
+/*******************************************************************************
+ *                      Functions Definitions (Private)                        *
+ *******************************************************************************/
+
+static uint64 g_mark_ns;
+
+static void timing_mark(void) {
+	g_mark_ns = GPIO_SIM_getTimeNs();
+}
+
+static void timing_report(const char *a_name, uint32 a_count) {
+	uint64 ns = GPIO_SIM_getTimeNs() - g_mark_ns;
+	printf("%-28s %10.3f us", a_name, ns / 1000.0);
+	if (a_count > 1) {
+		printf("  (%.3f us each)", ns / 1000.0 / a_count);
+	}
+	printf("\n");
+}
+
+/*******************************************************************************
+ *                                  Main                                       *
+ *******************************************************************************/
+
+int main(int argc, char **argv) {
+	const char *path = (argc > 1) ? argv[1] : "gpio.vcd";
+	const uint8 text[] = "0123456789ABCDEF";
+	GPIO_SIM_StatsType stats;
+	uint8 key;
+
+	if (!GPIO_SIM_open(path)) {
+		fprintf(stderr, "cannot create %s\n", path);
+		return 1;
+	}
+
+	printf("LCD_MODE %u\n", LCD_MODE);
+	timing_mark();
+	LCD_init();
+	timing_report("LCD_init", 1);
+
+	timing_mark();
+	LCD_sendCommand(LCD_COMMAND_CLEAR);
+	timing_report("LCD_sendCommand(clear)", 1);
+
+	timing_mark();
+	LCD_displayCharacter('A');
+	timing_report("LCD_displayCharacter", 1);
+
+	timing_mark();
+	LCD_displayString(text);
+	timing_report("LCD_displayString(16)", sizeof(text) - 1);
+
+	timing_mark();
+	key = KEYPAD_scan();
+	timing_report("KEYPAD_scan (no key)", 1);
+	printf("%-28s %10u\n", "  key", key);
+
+	/* Press the key of row 1, column 2 */
+	GPIO_SIM_connect(KEYPAD_PORT_ID, KEYPAD_FIRST_ROW_PIN_ID + 1,
+			KEYPAD_PORT_ID, KEYPAD_FIRST_COLUMN_PIN_ID + 2);
+	timing_mark();
+	key = KEYPAD_scan();
+	timing_report("KEYPAD_scan (row 1, col 2)", 1);
+	printf("%-28s %10u\n", "  key", key);
+	GPIO_SIM_disconnectAll();
+
+	GPIO_SIM_getStats(&stats);
+	printf("\ntotal %.3f us: gpio %.3f us, delays %.3f us\n",
+			GPIO_SIM_getTimeNs() / 1000.0, stats.access_time_ns / 1000.0,
+			stats.delay_time_ns / 1000.0);
+	printf("reads %lu, writes %lu, transitions %lu\n",
+			(unsigned long) stats.reads, (unsigned long) stats.writes,
+			(unsigned long) stats.transitions);
+
+	GPIO_SIM_close();
+	return 0;
+}
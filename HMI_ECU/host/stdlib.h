@@ -0,0 +1,24 @@
+/******************************************************************************
+ *
+ * Module: GPIO - Host simulation
+ *
+ * File Name: stdlib.h
+ *
+ * Description: Host wrapper of <stdlib.h> declaring itoa, the avr-libc
+ * 				extension used by LCD_integerToString which glibc lacks. The
+ * 				shim itself is defined in gpio_timing.c.
+ *
+ * Date Created: 18/10/2026
+ *
+ * Author: Hazem Montasser
+ *
+ *******************************************************************************/
+
+#ifndef GPIO_SIM_STDLIB_H_
+#define GPIO_SIM_STDLIB_H_
+
+#include_next <stdlib.h>
+
+char* itoa(int a_value, char *a_str, int a_radix);
+
+#endif /* GPIO_SIM_STDLIB_H_ */
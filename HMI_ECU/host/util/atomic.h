@@ -0,0 +1,23 @@
+/******************************************************************************
+ *
+ * Module: GPIO - Host simulation
+ *
+ * File Name: atomic.h
+ *
+ * Description: Host replacement of <util/atomic.h>, the simulation has no
+ * 				interrupts so the blocks run once as plain code.
+ *
+ * Date Created: 18/10/2026
+ *
+ * Author: Hazem Montasser
+ *
+ *******************************************************************************/
+
+#ifndef GPIO_SIM_UTIL_ATOMIC_H_
+#define GPIO_SIM_UTIL_ATOMIC_H_
+
+#define ATOMIC_RESTORESTATE
+#define ATOMIC_FORCEON
+#define ATOMIC_BLOCK(type) 	for (int atomic_once = 1; atomic_once; atomic_once = 0)
+
+#endif /* GPIO_SIM_UTIL_ATOMIC_H_ */
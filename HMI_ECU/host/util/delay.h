@@ -0,0 +1,25 @@
+/******************************************************************************
+ *
+ * Module: GPIO - Host simulation
+ *
+ * File Name: delay.h
+ *
+ * Description: Host replacement of <util/delay.h>, the busy waits advance the
+ * 				virtual clock of the GPIO simulation by their exact length
+ * 				instead of spinning.
+ *
+ * Date Created: 18/10/2026
+ *
+ * Author: Hazem Montasser
+ *
+ *******************************************************************************/
+
+#ifndef GPIO_SIM_UTIL_DELAY_H_
+#define GPIO_SIM_UTIL_DELAY_H_
+
+#include "gpio_sim.h"
+
+#define _delay_us(us) 	GPIO_SIM_advanceTimeNs((uint64) ((us) * 1000.0))
+#define _delay_ms(ms) 	GPIO_SIM_advanceTimeNs((uint64) ((ms) * 1000000.0))
+
+#endif /* GPIO_SIM_UTIL_DELAY_H_ */
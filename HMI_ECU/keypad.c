@@ -12,6 +12,7 @@
 #include "common_macros.h" /* To use the macros like SET_BIT */
 #include "keypad.h"
 #include "gpio.h"
+#include <avr/cpufunc.h> /* To use _NOP */
 
 /*******************************************************************************
  *                      Functions Prototypes(Private)                          *
@@ -35,43 +36,67 @@ static uint8 KEYPAD_4x4_adjustKeyNumber(uint8 button_number);
  *                      Functions Definitions                                  *
  *******************************************************************************/
 uint8 KEYPAD_getPressedKey(void)
+{
+	uint8 key;
+	(void)KEYPAD_getPressedKeyTimeout(&key,TIMEOUT_FOREVER);
+	return key;
+}
+
+Timeout_StatusType KEYPAD_getPressedKeyTimeout(uint8 *a_key,const Timeout_DeadlineType *a_deadline)
+{
+	uint8 key;
+	for(;;)
+	{
+		key = KEYPAD_scan();
+		if(key != KEYPAD_NO_KEY)
+		{
+			*a_key = key;
+			return TIMEOUT_STATUS_OK;
+		}
+		if(Timeout_check(a_deadline,TIMEOUT_SITE_KEYPAD) != TIMEOUT_STATUS_OK)
+		{
+			return TIMEOUT_STATUS_EXPIRED;
+		}
+	}
+}
+
+uint8 KEYPAD_scan(void)
 {
 	uint8 col,row;
 	uint8 keypad_port_value = 0;
-	while(1)
+	for(col=0;col<KEYPAD_NUM_COLS;col++) /* loop for columns */
 	{
-		for(col=0;col<KEYPAD_NUM_COLS;col++) /* loop for columns */
-		{
-			/* 
-			 * Each time setup the direction for all keypad port as input pins,
-			 * except this column will be output pin
-			 */
-			GPIO_setupPortDirection(KEYPAD_PORT_ID,PORT_INPUT);
-			GPIO_setupPinDirection(KEYPAD_PORT_ID,KEYPAD_FIRST_COLUMN_PIN_ID+col,PIN_OUTPUT);
-			
+		/* 
+		 * Each time setup the direction for all keypad port as input pins,
+		 * except this column will be output pin
+		 */
+		GPIO_WRITE_DDR(KEYPAD_PORT_ID,(1<<(KEYPAD_FIRST_COLUMN_PIN_ID+col)));
+		
 #if(KEYPAD_BUTTON_PRESSED == LOGIC_LOW)
-			/* Clear the column output pin and set the rest pins value */
-			keypad_port_value = ~(1<<(KEYPAD_FIRST_COLUMN_PIN_ID+col));
+		/* Clear the column output pin and set the rest pins value */
+		keypad_port_value = ~(1<<(KEYPAD_FIRST_COLUMN_PIN_ID+col));
 #else
-			/* Set the column output pin and clear the rest pins value */
-			keypad_port_value = (1<<(KEYPAD_FIRST_COLUMN_PIN_ID+col));
+		/* Set the column output pin and clear the rest pins value */
+		keypad_port_value = (1<<(KEYPAD_FIRST_COLUMN_PIN_ID+col));
 #endif
-			GPIO_writePort(KEYPAD_PORT_ID,keypad_port_value);
+		GPIO_WRITE_PORT(KEYPAD_PORT_ID,keypad_port_value);
+		/* One cycle for the input synchronizer to latch the column level */
+		_NOP();
 
-			for(row=0;row<KEYPAD_NUM_ROWS;row++) /* loop for rows */
+		for(row=0;row<KEYPAD_NUM_ROWS;row++) /* loop for rows */
+		{
+			/* Check if the switch is pressed in this row */
+			if(GPIO_READ_PIN(KEYPAD_PORT_ID,row+KEYPAD_FIRST_ROW_PIN_ID) == KEYPAD_BUTTON_PRESSED)
 			{
-				/* Check if the switch is pressed in this row */
-				if(GPIO_readPin(KEYPAD_PORT_ID,row+KEYPAD_FIRST_ROW_PIN_ID) == KEYPAD_BUTTON_PRESSED)
-				{
-					#if (KEYPAD_NUM_COLS == 3)
-						return KEYPAD_4x3_adjustKeyNumber((row*KEYPAD_NUM_COLS)+col+1);
-					#elif (KEYPAD_NUM_COLS == 4)
-						return KEYPAD_4x4_adjustKeyNumber((row*KEYPAD_NUM_COLS)+col+1);
-					#endif
-				}
+				#if (KEYPAD_NUM_COLS == 3)
+					return KEYPAD_4x3_adjustKeyNumber((row*KEYPAD_NUM_COLS)+col+1);
+				#elif (KEYPAD_NUM_COLS == 4)
+					return KEYPAD_4x4_adjustKeyNumber((row*KEYPAD_NUM_COLS)+col+1);
+				#endif
 			}
 		}
-	}	
+	}
+	return KEYPAD_NO_KEY;
 }
 
 #if (KEYPAD_NUM_COLS == 3)
@@ -14,6 +14,7 @@
 #define KEYPAD_H_
 
 #include "std_types.h"
+#include "timeout.h"
 
 /*******************************************************************************
  *                                Definitions                                  *
@@ -33,6 +34,9 @@
 #define KEYPAD_BUTTON_PRESSED            LOGIC_LOW
 #define KEYPAD_BUTTON_RELEASED           LOGIC_HIGH
 
+/* Returned by KEYPAD_scan when no button is pressed */
+#define KEYPAD_NO_KEY                    0xFF
+
 /*******************************************************************************
  *                      Functions Prototypes                                   *
  *******************************************************************************/
@@ -43,4 +47,19 @@
  */
 uint8 KEYPAD_getPressedKey(void);
 
+/*
+ * Description :
+ * Get the Keypad pressed button, giving up (a_key untouched) if none is
+ * pressed before the deadline (TIMEOUT_FOREVER = no bound)
+ */
+Timeout_StatusType KEYPAD_getPressedKeyTimeout(uint8 *a_key,
+		const Timeout_DeadlineType *a_deadline);
+
+/*
+ * Description :
+ * Scan the Keypad once and return the pressed button or KEYPAD_NO_KEY
+ * without waiting
+ */
+uint8 KEYPAD_scan(void);
+
 #endif /* KEYPAD_H_ */
@@ -12,180 +12,445 @@
 
 #include "lcd.h"
 #include "gpio.h"
+#include "profiler.h"
 #include "util/delay.h"
+#if (LCD_QUEUE_ENABLE == TRUE)
+#include "timer.h"
+#endif
 #include <stdlib.h>	/*To use itoa function*/
+#include <avr/pgmspace.h>	/*To read strings from flash*/
 
-/*Description: Sends a command to the LCD as given by a_data */
-void LCD_sendCommand(uint8 a_data) {
+/*******************************************************************************
+ *                          Pin Accessors (Private)                            *
+ *******************************************************************************/
+GPIO_DEFINE_PIN(lcd_rs, LCD_CONTROL_PORT, LCD_RS);
+GPIO_DEFINE_PIN(lcd_rw, LCD_CONTROL_PORT, LCD_RW);
+GPIO_DEFINE_PIN(lcd_enable, LCD_CONTROL_PORT, LCD_ENABLE);
 
-	/*RS = 0 to send command*/
-	GPIO_writePin(LCD_CONTROL_PORT, LCD_RS, LOGIC_LOW);
+/* Data bus pins of LCD_DATA_PORT, and a nibble to/from their position */
+#if (LCD_MODE==8)
+#define LCD_DATA_MASK (0xFF)
+#define LCD_OTHERS_MASK (0x00)
+#elif (LCD_FIRST_4_PINS==1)
+#define LCD_DATA_MASK (0x0F)
+#define LCD_OTHERS_MASK (0xF0)
+#define LCD_NIBBLE_TO_BUS(nibble) ((nibble) & 0x0F)
+#define LCD_BUS_TO_NIBBLE(bus) ((bus) & 0x0F)
+#else
+#define LCD_DATA_MASK (0xF0)
+#define LCD_OTHERS_MASK (0x0F)
+#define LCD_NIBBLE_TO_BUS(nibble) ((uint8) ((nibble) << 4))
+#define LCD_BUS_TO_NIBBLE(bus) ((bus) >> 4)
+#endif
 
-	/*R/W = 0 to write to LCD*/
-	GPIO_writePin(LCD_CONTROL_PORT, LCD_RW, LOGIC_LOW);
+#if (LCD_QUEUE_ENABLE == TRUE)
+/* Build fails here if F_CPU can't give the queue tick on Timer0 */
+TIMER_PERIOD_ASSERT(TIMER0_ID, LCD_QUEUE_TICK_US, lcd_queue);
+#if (LCD_QUEUE_SIZE & (LCD_QUEUE_SIZE - 1)) || (LCD_QUEUE_SIZE > 128)
+#error "LCD_QUEUE_SIZE must be a power of 2, at most 128"
+#endif
+/* Queue ticks of the clear/home fallback delay */
+#define LCD_QUEUE_LONG_TICKS ((LCD_DELAY_LONG_MS * 1000UL + LCD_QUEUE_TICK_US - 1) / LCD_QUEUE_TICK_US)
+#endif
 
-	/*tas = 50ns*/
-	_delay_us(20);
+/*******************************************************************************
+ *                         Global Variables(Private)                           *
+ *******************************************************************************/
+static uint8 g_frame[LCD_MAX_ROWS][LCD_MAX_COLS]; /* Screen drawn by the application */
+static uint8 g_shown[LCD_MAX_ROWS][LCD_MAX_COLS]; /* Screen shown on the LCD */
+static uint16 g_frame_dirty[LCD_MAX_ROWS]; /* Bit per column, set if g_frame differs from g_shown */
+static uint8 g_frame_row = 0; /* Frame cursor */
+static uint8 g_frame_col = 0;
+static uint8 g_lcd_row = 0; /* LCD address counter, LCD_MAX_ROWS if not in the display RAM */
+static uint8 g_lcd_col = 0;
+/* PORT & DDR bits of the data port pins not on the bus, copied by LCD_init so
+ * the bus is written without reading the port back, then only changed through
+ * LCD_writeOtherPins and LCD_setupOtherPinsDirection */
+static uint8 g_port_others = 0;
+static uint8 g_ddr_others = 0;
+static volatile boolean g_busy_flag = TRUE; /* Busy flag is read, FALSE after it timed out */
+static const uint8 g_row_address[LCD_MAX_ROWS] = { LCD_REG_COL_0, LCD_REG_COL_1,
+		LCD_REG_COL_2, LCD_REG_COL_3 };
+#if (LCD_QUEUE_ENABLE == TRUE)
+static uint8 g_queue[LCD_QUEUE_SIZE]; /* Bytes to send */
+static uint8 g_queue_rs[LCD_QUEUE_SIZE / 8]; /* RS bit of every byte */
+static volatile uint8 g_queue_head = 0; /* Free-running, written by the caller */
+static volatile uint8 g_queue_tail = 0; /* Free-running, written by the ISR */
+static volatile boolean g_queue_running = FALSE; /* Timer0 ticks */
+static volatile uint8 g_queue_hold = 0; /* Ticks to wait before the next byte (fallback) */
+static uint16 g_queue_busy_ticks = 0; /* Ticks the LCD stayed busy */
+#endif
+
+/*******************************************************************************
+ *                      Functions Definitions (Private)                        *
+ *******************************************************************************/
 
-	/*Enable = 1 before sending data*/
-	GPIO_writePin(LCD_CONTROL_PORT, LCD_ENABLE, LOGIC_HIGH);
+/*
+ * Description :
+ * Sets the direction of the data bus pins, the other pins of the port keep the
+ * direction they had at LCD_init.
+ */
+static void lcd_dataDirection(uint8 a_direction) {
+	GPIO_WRITE_DDR(LCD_DATA_PORT, g_ddr_others | (a_direction & LCD_DATA_MASK));
+}
 
-	/*tpw - tdsw = 190ns*/
-	_delay_us(20);
-#if (LCD_4BIT_MODE==4 && LCD_FIRST_4_PINS==1)
+/*
+ * Description :
+ * One enable pulse, the LCD latches the bus on the falling edge.
+ * tPW = 230ns, tcycE = 500ns.
+ */
+static void lcd_pulse(void) {
+	lcd_enable_high();
+	_delay_us(LCD_PULSE_US);
+	lcd_enable_low();
+	_delay_us(LCD_PULSE_US);
+}
 
-	/*Send higher 4 bits first and other bit states*/
-	GPIO_writePort(LCD_DATA_PORT,
-			(a_data >> LCD_4BIT_MODE) | (GPIO_readPort(LCD_DATA_PORT) & 0xF0));
-#elif	 (LCD_4BIT_MODE==4 && LCD_LAST_4_PINS==1)
-	GPIO_writePort(LCD_DATA_PORT,
-			(a_data & 0xF0) | (GPIO_readPort(LCD_DATA_PORT) & 0x0F));
+/*
+ * Description :
+ * One enable pulse reading the bus, the LCD drives it tDDR = 160ns after the
+ * rising edge until the falling edge.
+ */
+static uint8 lcd_pulseRead(void) {
+	uint8 bus;
+	lcd_enable_high();
+	_delay_us(LCD_PULSE_US);
+	bus = GPIO_READ_PORT(LCD_DATA_PORT);
+	lcd_enable_low();
+	_delay_us(LCD_PULSE_US);
+	return bus;
+}
 
+/*
+ * Description :
+ * Reads the status byte: busy flag (bit 7) and address counter (bits 0-6).
+ */
+static uint8 lcd_readStatus(void) {
+	uint8 status;
+	/* Release the bus (no pull-ups) before the LCD drives it, RS = 0, R/W = 1 to read */
+	GPIO_WRITE_PORT(LCD_DATA_PORT, g_port_others);
+	lcd_dataDirection(PORT_INPUT);
+	GPIO_writePinsAtomic(LCD_CONTROL_PORT, (1 << LCD_RW), (1 << LCD_RS));
+#if (LCD_MODE==4)
+	/* Higher nibble first */
+	status = LCD_BUS_TO_NIBBLE(lcd_pulseRead()) << 4;
+	status |= LCD_BUS_TO_NIBBLE(lcd_pulseRead());
 #else
-	GPIO_writePort(LCD_DATA_PORT, (a_data));
+	status = lcd_pulseRead();
 #endif
-	/*tdsw = 100ns*/
-	_delay_us(20);
-
-	/*Enable == 0 after sending data*/
-	GPIO_writePin(LCD_CONTROL_PORT, LCD_ENABLE, LOGIC_LOW);
-	_delay_us(20);
-#if (LCD_4BIT_MODE==4 && LCD_FIRST_4_PINS==1)
-
-	/*Enable = 1 before sending data*/
-	GPIO_writePin(LCD_CONTROL_PORT, LCD_ENABLE, LOGIC_HIGH);
-
-	/*tpw - tdsw = 190ns*/
-	_delay_us(20);
-
-	/*Send lower 4 bits first and preserve other bit states*/
-	GPIO_writePort(LCD_DATA_PORT,
-			(a_data & 0x0F) | (GPIO_readPort(LCD_DATA_PORT) & 0xF0));
-	/*tdsw = 100ns*/
-	_delay_us(20);
-
-	/*Enable == 0 after sending data*/
-	GPIO_writePin(LCD_CONTROL_PORT, LCD_ENABLE, LOGIC_LOW);
-#elif	 (LCD_4BIT_MODE==4 && LCD_LAST_4_PINS==1)
-	/*Enable = 1 before sending data*/
-	GPIO_writePin(LCD_CONTROL_PORT, LCD_ENABLE, LOGIC_HIGH);
-
-	/*tpw - tdsw = 190ns*/
-	_delay_us(20);
-	GPIO_writePort(LCD_DATA_PORT,
-			(a_data << LCD_4BIT_MODE) | (GPIO_readPort(LCD_DATA_PORT) & 0x0F));
-
-	/*tdsw = 100ns*/
-	_delay_us(20);
-
-	/*Enable == 0 after sending data*/
-	GPIO_writePin(LCD_CONTROL_PORT, LCD_ENABLE, LOGIC_LOW);
+	lcd_rw_low();
+	lcd_dataDirection(PORT_OUTPUT);
+	return status;
+}
+
+/*
+ * Description :
+ * Waits until the LCD clears its busy flag. If it stays busy for
+ * LCD_BUSY_TIMEOUT_US (no LCD, R/W not wired) the flag is no longer read and
+ * every transfer is followed by its worst case delay instead.
+ */
+static void lcd_waitReady(void) {
+	/* A poll lasts at least the 2 halves of the enable pulse */
+	for (uint16 polls = 0; g_busy_flag && polls < LCD_BUSY_TIMEOUT_US / (2 * LCD_PULSE_US);
+			polls++) {
+		if (!(lcd_readStatus() & LCD_BUSY_FLAG)) {
+			return;
+		}
+	}
+	g_busy_flag = FALSE;
+}
+
+/*
+ * Description :
+ * Puts one byte on the bus to the instruction (a_rs = LOGIC_LOW) or data
+ * (a_rs = LOGIC_HIGH) register, the LCD must be ready.
+ */
+static void lcd_transfer(uint8 a_rs, uint8 a_data) {
+#if (LCD_MODE==4)
+	/*Port values of both nibbles prepared before the first one is sent*/
+	uint8 high = g_port_others | LCD_NIBBLE_TO_BUS(a_data >> 4);
+	uint8 low = g_port_others | LCD_NIBBLE_TO_BUS(a_data & 0x0F);
+#endif
+	/*R/W = 0 to write to LCD, RS selects the register, tas = 50ns*/
+	if (a_rs == LOGIC_HIGH) {
+		GPIO_writePinsAtomic(LCD_CONTROL_PORT, (1 << LCD_RS), (1 << LCD_RW));
+	} else {
+		GPIO_writePinsAtomic(LCD_CONTROL_PORT, 0, (1 << LCD_RS) | (1 << LCD_RW));
+	}
+
+	/*Data is set before the enable pulse, tdsw = 80ns*/
+#if (LCD_MODE==4)
+	/*Both nibbles are written as whole port values, higher nibble first*/
+	GPIO_WRITE_PORT(LCD_DATA_PORT, high);
+	lcd_pulse();
+	GPIO_WRITE_PORT(LCD_DATA_PORT, low);
+	lcd_pulse();
+#else
+	GPIO_WRITE_PORT(LCD_DATA_PORT, a_data);
+	lcd_pulse();
 #endif
+}
 
-	/*Safety*/
-	_delay_us(20);
+/*
+ * Description :
+ * Sends one command of the reset sequence, the LCD may be in either bus width:
+ * in 4-bit mode only the higher nibble is sent.
+ */
+static void lcd_transferReset(uint8 a_nibble) {
+	GPIO_writePinsAtomic(LCD_CONTROL_PORT, 0, (1 << LCD_RS) | (1 << LCD_RW));
+#if (LCD_MODE==4)
+	GPIO_WRITE_PORT(LCD_DATA_PORT, g_port_others | LCD_NIBBLE_TO_BUS(a_nibble));
+#else
+	GPIO_WRITE_PORT(LCD_DATA_PORT, a_nibble << 4);
+#endif
+	lcd_pulse();
+}
+
+/*
+ * Description :
+ * Sends one byte as soon as the LCD is ready, after the queued bytes.
+ */
+static void lcd_write(uint8 a_rs, uint8 a_data) {
+	LCD_flush();
+	lcd_waitReady();
+	lcd_transfer(a_rs, a_data);
+
+	if (!g_busy_flag) {
+		/*Clear and return home take 1.52ms, the other transfers 37us*/
+		if ((a_rs == LOGIC_LOW) && (a_data <= LCD_COMMAND_HOME)) {
+			_delay_ms(LCD_DELAY_LONG_MS);
+		} else {
+			_delay_us(LCD_DELAY_SHORT_US);
+		}
+	}
+}
+
+#if (LCD_QUEUE_ENABLE == TRUE)
+/*
+ * Description :
+ * Timer0 compare callback (ISR context): sends the next queued byte if the LCD
+ * is ready, else tries again on the next tick. Timer0 is stopped once the
+ * queue is empty.
+ */
+static void lcd_queueTick(void) {
+	uint8 index;
+	uint8 rs;
+	if (g_queue_hold != 0) {
+		g_queue_hold--;
+		return;
+	}
+	if (g_queue_tail == g_queue_head) {
+		Timer_stop(TIMER0_ID);
+		g_queue_running = FALSE;
+		return;
+	}
+	if (g_busy_flag) {
+		if (lcd_readStatus() & LCD_BUSY_FLAG) {
+			if (++g_queue_busy_ticks < LCD_BUSY_TIMEOUT_US / LCD_QUEUE_TICK_US) {
+				return;
+			}
+			g_busy_flag = FALSE;
+		}
+		g_queue_busy_ticks = 0;
+	}
+	index = g_queue_tail & (LCD_QUEUE_SIZE - 1);
+	rs = BIT_IS_SET(g_queue_rs[index >> 3], index & 0x07) ? LOGIC_HIGH : LOGIC_LOW;
+	lcd_transfer(rs, g_queue[index]);
+	g_queue_tail++;
+	/* Without the busy flag one tick covers the short transfers */
+	if (!g_busy_flag && (rs == LOGIC_LOW) && (g_queue[index] <= LCD_COMMAND_HOME)) {
+		g_queue_hold = LCD_QUEUE_LONG_TICKS;
+	}
+}
+#endif
+
+/*
+ * Description :
+ * Sends one byte in the background when the queue is enabled, else at once.
+ */
+static void lcd_put(uint8 a_rs, uint8 a_data) {
+#if (LCD_QUEUE_ENABLE == TRUE)
+	uint8 index;
+	/* Full: wait for the ISR to make room */
+	while ((uint8) (g_queue_head - g_queue_tail) >= LCD_QUEUE_SIZE) {
+	}
+	index = g_queue_head & (LCD_QUEUE_SIZE - 1);
+	g_queue[index] = a_data;
+	if (a_rs == LOGIC_HIGH) {
+		SET_BIT(g_queue_rs[index >> 3], index & 0x07);
+	} else {
+		CLEAR_BIT(g_queue_rs[index >> 3], index & 0x07);
+	}
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		g_queue_head++;
+		if (!g_queue_running) {
+			g_queue_running = TRUE;
+			Timer_resetTimerValue(TIMER0_ID);
+			Timer_resume(TIMER0_ID);
+		}
+	}
+#else
+	lcd_write(a_rs, a_data);
+#endif
+}
+
+/*******************************************************************************
+ *                              Functions Definitions                          *
+ *******************************************************************************/
+
+/*Description: Sends a command to the LCD as given by a_data */
+void LCD_sendCommand(uint8 a_data) {
+	lcd_write(LOGIC_LOW, a_data);
 }
 
 /*Description: Displays a single character given by a_char */
 void LCD_displayCharacter(uint8 a_data) {
+	lcd_write(LOGIC_HIGH, a_data);
+}
 
-	/*RS = 1 to send data*/
-	GPIO_writePin(LCD_CONTROL_PORT, LCD_RS, LOGIC_HIGH);
-
-	/*R/W = 0 to write to LCD*/
-	GPIO_writePin(LCD_CONTROL_PORT, LCD_RW, LOGIC_LOW);
+/*Description: Returns the address counter of the LCD once it is ready,
+ * LCD_ADDRESS_UNKNOWN if the busy flag cannot be read
+ * */
+uint8 LCD_getAddress(void) {
+	/* The background writer must not drive the bus during the status read */
+	LCD_flush();
+	lcd_waitReady();
+	if (!g_busy_flag) {
+		return LCD_ADDRESS_UNKNOWN;
+	}
+	return lcd_readStatus() & ~LCD_BUSY_FLAG;
+}
 
-	/*tas = 50ns*/
-	_delay_us(20);
+/*Description: Queues a command for the background writer */
+void LCD_queueCommand(uint8 a_data) {
+	lcd_put(LOGIC_LOW, a_data);
+}
 
-	/*Enable = 1 before sending data*/
-	GPIO_writePin(LCD_CONTROL_PORT, LCD_ENABLE, LOGIC_HIGH);
+/*Description: Queues a character for the background writer */
+void LCD_queueCharacter(uint8 a_char) {
+	lcd_put(LOGIC_HIGH, a_char);
+}
 
-	/*tpw - tdsw = 190ns*/
-	_delay_us(20);
-#if (LCD_4BIT_MODE==4 && LCD_FIRST_4_PINS==1)
+/*Description: Queues a string for the background writer */
+void LCD_queueString(const uint8 *a_str) {
+	while (*a_str != '\0') {
+		lcd_put(LOGIC_HIGH, *a_str++);
+	}
+}
 
-	/*Send higher 4 bits first and other bit states*/
-	GPIO_writePort(LCD_DATA_PORT,
-			(a_data >> LCD_4BIT_MODE) | (GPIO_readPort(LCD_DATA_PORT) & 0xF0));
-#elif	 (LCD_4BIT_MODE==4 && LCD_LAST_4_PINS==1)
-	GPIO_writePort(LCD_DATA_PORT,
-			(a_data & 0xF0) | (GPIO_readPort(LCD_DATA_PORT) & 0x0F));
+/*
+ * Description: Queues the upload of a custom character to a CGRAM slot from
+ * LCD_CGRAM_ROWS bytes in program memory (bits 4-0 of each pixel row). The
+ * next frame refresh moves the cursor back to the display RAM.
+ * */
+void LCD_defineCharacter_P(uint8 a_slot, const uint8 *a_pattern) {
+	if (a_slot >= LCD_CGRAM_SLOTS) {
+		return;
+	}
+	lcd_put(LOGIC_LOW, LCD_COMMAND_CGRAM | (a_slot * LCD_CGRAM_ROWS));
+	for (uint8 row = 0; row < LCD_CGRAM_ROWS; row++) {
+		lcd_put(LOGIC_HIGH, pgm_read_byte(&a_pattern[row]));
+	}
+	/* The address counter points to the CGRAM now */
+	g_lcd_row = LCD_MAX_ROWS;
+}
 
+/*Description: Returns TRUE once every queued byte was sent */
+boolean LCD_isIdle(void) {
+#if (LCD_QUEUE_ENABLE == TRUE)
+	return !g_queue_running;
 #else
-	GPIO_writePort(LCD_DATA_PORT, (a_data));
-#endif
-	/*tdsw = 100ns*/
-	_delay_us(20);
-
-	/*Enable == 0 after sending data*/
-	GPIO_writePin(LCD_CONTROL_PORT, LCD_ENABLE, LOGIC_LOW);
-	_delay_us(20);
-#if (LCD_4BIT_MODE==4 && LCD_FIRST_4_PINS==1)
-
-	/*Enable = 1 before sending data*/
-	GPIO_writePin(LCD_CONTROL_PORT, LCD_ENABLE, LOGIC_HIGH);
-
-	/*tpw - tdsw = 190ns*/
-	_delay_us(20);
-
-	/*Send lower 4 bits first and preserve other bit states*/
-	GPIO_writePort(LCD_DATA_PORT,
-			(a_data & 0x0F) | (GPIO_readPort(LCD_DATA_PORT) & 0xF0));
-	/*tdsw = 100ns*/
-	_delay_us(20);
-
-	/*Enable == 0 after sending data*/
-	GPIO_writePin(LCD_CONTROL_PORT, LCD_ENABLE, LOGIC_LOW);
-#elif	 (LCD_4BIT_MODE==4 && LCD_LAST_4_PINS==1)
-	/*Enable = 1 before sending data*/
-	GPIO_writePin(LCD_CONTROL_PORT, LCD_ENABLE, LOGIC_HIGH);
-
-	/*tpw - tdsw = 190ns*/
-	_delay_us(20);
-	GPIO_writePort(LCD_DATA_PORT,
-			(a_data << LCD_4BIT_MODE) | (GPIO_readPort(LCD_DATA_PORT) & 0x0F));
-
-	/*tdsw = 100ns*/
-	_delay_us(20);
-
-	/*Enable == 0 after sending data*/
-	GPIO_writePin(LCD_CONTROL_PORT, LCD_ENABLE, LOGIC_LOW);
+	return TRUE;
 #endif
+}
 
-	/*Safety*/
-	_delay_us(20);
+/*Description: Waits until every queued byte was sent */
+void LCD_flush(void) {
+	while (!LCD_isIdle()) {
+	}
 }
 
 /*Description: Initializes the LCD data bus & control pins
  * according to the pre-dfined preprocessor definitions
  * */
 void LCD_init(void) {
-	GPIO_setupPinDirection(LCD_CONTROL_PORT, LCD_RS, PIN_OUTPUT);
-	GPIO_setupPinDirection(LCD_CONTROL_PORT, LCD_RW, PIN_OUTPUT);
-	GPIO_setupPinDirection(LCD_CONTROL_PORT, LCD_ENABLE, PIN_OUTPUT);
-#if (LCD_MODE==8)
-	GPIO_setupPortDirection(LCD_DATA_PORT, PORT_OUTPUT);
-#elif (LCD_MODE==4 && LCD_FIRST_4_PINS==1)
-	GPIO_setupPinDirection(LCD_DATA_PORT, PIN0_ID, PIN_OUTPUT);
-	GPIO_setupPinDirection(LCD_DATA_PORT, PIN0_ID+1, PIN_OUTPUT);
-	GPIO_setupPinDirection(LCD_DATA_PORT, PIN0_ID+2, PIN_OUTPUT);
-	GPIO_setupPinDirection(LCD_DATA_PORT, PIN0_ID+3, PIN_OUTPUT);
-#elif (LCD_MODE==4 && LCD_LAST_4_PINS==1)
-	GPIO_setupPinDirection(LCD_DATA_PORT, PIN4_ID, PIN_OUTPUT);
-	GPIO_setupPinDirection(LCD_DATA_PORT, PIN4_ID+1, PIN_OUTPUT);
-	GPIO_setupPinDirection(LCD_DATA_PORT, PIN4_ID+2, PIN_OUTPUT);
- 	GPIO_setupPinDirection(LCD_DATA_PORT, PIN4_ID+3, PIN_OUTPUT);
+#if (LCD_QUEUE_ENABLE == TRUE)
+	Timer_ConfigType QUEUE_CONFIG = TIMER_CONFIG_PERIOD(TIMER0_ID,
+			LCD_QUEUE_TICK_US, TRUE);
 #endif
-
-#if (LCD_MODE==4 )
-	LCD_sendCommand(LCD_COMMAND_4BIT_INIT);
+	lcd_rs_output();
+	lcd_rw_output();
+	lcd_enable_output();
+	g_port_others = GPIO_PORT_REG(LCD_DATA_PORT) & LCD_OTHERS_MASK;
+	g_ddr_others = GPIO_DDR_REG(LCD_DATA_PORT) & LCD_OTHERS_MASK;
+	lcd_dataDirection(PORT_OUTPUT);
+	g_busy_flag = TRUE;
+
+	/*Initialization by instruction (HD44780U datasheet, figures 23 & 24):
+	 * the bus width is unknown and the busy flag can't be read until it is set*/
+	_delay_ms(LCD_POWER_ON_MS);
+	lcd_transferReset(LCD_COMMAND_RESET);
+	_delay_ms(LCD_RESET_FIRST_MS);
+	lcd_transferReset(LCD_COMMAND_RESET);
+	_delay_us(LCD_RESET_NEXT_US);
+	lcd_transferReset(LCD_COMMAND_RESET);
+	_delay_us(LCD_RESET_NEXT_US);
+#if (LCD_MODE==4)
+	lcd_transferReset(LCD_COMMAND_4BIT_INIT);
+	_delay_us(LCD_RESET_NEXT_US);
 #endif
 
 	LCD_sendCommand(LCD_COMMAND_MODE);
-	LCD_sendCommand(LCD_COMMAND_CURSOR_OFF);
+	LCD_sendCommand(LCD_COMMAND_DISPLAY_OFF);
 	LCD_sendCommand(LCD_COMMAND_CLEAR);
+	LCD_sendCommand(LCD_COMMAND_ENTRY_MODE);
+	LCD_sendCommand(LCD_COMMAND_CURSOR_OFF);
 
+#if (LCD_QUEUE_ENABLE == TRUE)
+	/* Timer0 runs only while the queue is not empty */
+	Timer_setSourceCallback(TIMER0_COMP_SOURCE, lcd_queueTick);
+	Timer_init(&QUEUE_CONFIG);
+	Timer_stop(TIMER0_ID);
+#endif
+
+	/* The LCD is blank with its address counter at 0,0 */
+	for (uint8 row = 0; row < LCD_MAX_ROWS; row++) {
+		for (uint8 col = 0; col < LCD_MAX_COLS; col++) {
+			g_frame[row][col] = ' ';
+			g_shown[row][col] = ' ';
+		}
+		g_frame_dirty[row] = 0;
+	}
+	g_frame_row = 0;
+	g_frame_col = 0;
+	g_lcd_row = 0;
+	g_lcd_col = 0;
+}
+
+/*Description: Writes the data port pins not on the bus, and their copy */
+void LCD_writeOtherPins(uint8 a_mask, uint8 a_value) {
+	a_mask &= LCD_OTHERS_MASK;
+	/* The Timer0 ISR writes the whole port from the copy */
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		g_port_others = (g_port_others & (uint8) ~a_mask) | (a_value & a_mask);
+		GPIO_WRITE_PORT(LCD_DATA_PORT,
+				(GPIO_PORT_REG(LCD_DATA_PORT) & (uint8) ~a_mask)
+						| (g_port_others & a_mask));
+	}
+}
+
+/*Description: Sets the direction of the data port pins not on the bus, and their copy */
+void LCD_setupOtherPinsDirection(uint8 a_mask, uint8 a_direction) {
+	a_mask &= LCD_OTHERS_MASK;
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		g_ddr_others = (g_ddr_others & (uint8) ~a_mask) | (a_direction & a_mask);
+		GPIO_WRITE_DDR(LCD_DATA_PORT,
+				(GPIO_DDR_REG(LCD_DATA_PORT) & (uint8) ~a_mask)
+						| (g_ddr_others & a_mask));
+	}
 }
 
 /*Description: Displays a string on the LCD from a character array
@@ -194,12 +459,13 @@ void LCD_init(void) {
  * */
 void LCD_displayString(const uint8 *str) {
 	uint8 counter = 0;
+	PROFILE_BEGIN(PROBE_LCD_DISPLAY_STRING);
 
 	while (str[counter] != '\0') {
 		LCD_displayCharacter(str[counter]);
 		++counter;
 	}
-
+	PROFILE_END(PROBE_LCD_DISPLAY_STRING);
 }
 
 /*
@@ -249,6 +515,21 @@ void LCD_displayStringRowColumn(uint8 a_row, uint8 a_col, const uint8 *a_str) {
 
 }
 
+/*Description: LCD_displayString for a string in program memory */
+void LCD_displayString_P(const uint8 *a_str) {
+	uint8 character = pgm_read_byte(a_str);
+	while (character != '\0') {
+		LCD_displayCharacter(character);
+		character = pgm_read_byte(++a_str);
+	}
+}
+
+/*Description: LCD_displayStringRowColumn for a string in program memory */
+void LCD_displayStringRowColumn_P(uint8 a_row, uint8 a_col, const uint8 *a_str) {
+	LCD_moveCursor(a_row, a_col);
+	LCD_displayString_P(a_str);
+}
+
 /*
  * Description: Clears the LCD by sending the LCD_COMMAND_CLEAR command to the LCD
  * */
@@ -272,3 +553,97 @@ void LCD_integerToString(int a_data) {
 	/* Display the converted integer */
 	LCD_displayString(buff);
 }
+
+/*Description: Fills the frame with spaces and moves the frame cursor to 0,0 */
+void LCD_frameClear(void) {
+	for (uint8 row = 0; row < LCD_MAX_ROWS; row++) {
+		LCD_frameMoveCursor(row, 0);
+		while (g_frame_col < LCD_MAX_COLS) {
+			LCD_frameCharacter(' ');
+		}
+	}
+	LCD_frameMoveCursor(LCD_ROW_0, 0);
+}
+
+/*Description: Moves the frame cursor, out of range positions are ignored */
+void LCD_frameMoveCursor(uint8 a_row, uint8 a_col) {
+	if ((a_row < LCD_MAX_ROWS) && (a_col < LCD_MAX_COLS)) {
+		g_frame_row = a_row;
+		g_frame_col = a_col;
+	}
+}
+
+/*Description: Writes a character at the frame cursor and advances it,
+ * nothing is written past the end of the row
+ * */
+void LCD_frameCharacter(uint8 a_char) {
+	uint16 bit;
+	if (g_frame_col >= LCD_MAX_COLS) {
+		return;
+	}
+	bit = (uint16) 1 << g_frame_col;
+	g_frame[g_frame_row][g_frame_col] = a_char;
+	/* Writing back the shown character cancels a pending change */
+	if (a_char != g_shown[g_frame_row][g_frame_col]) {
+		g_frame_dirty[g_frame_row] |= bit;
+	} else {
+		g_frame_dirty[g_frame_row] &= ~bit;
+	}
+	g_frame_col++;
+}
+
+/*Description: Writes a string from the frame cursor until its end or the end of the row */
+void LCD_frameString(const uint8 *a_str) {
+	while ((*a_str != '\0') && (g_frame_col < LCD_MAX_COLS)) {
+		LCD_frameCharacter(*a_str++);
+	}
+}
+
+/*Description: Writes a string from the given row and column of the frame */
+void LCD_frameStringRowColumn(uint8 a_row, uint8 a_col, const uint8 *a_str) {
+	LCD_frameMoveCursor(a_row, a_col);
+	LCD_frameString(a_str);
+}
+
+/*Description: LCD_frameString for a string in program memory */
+void LCD_frameString_P(const uint8 *a_str) {
+	uint8 character = pgm_read_byte(a_str);
+	while ((character != '\0') && (g_frame_col < LCD_MAX_COLS)) {
+		LCD_frameCharacter(character);
+		character = pgm_read_byte(++a_str);
+	}
+}
+
+/*Description: LCD_frameStringRowColumn for a string in program memory */
+void LCD_frameStringRowColumn_P(uint8 a_row, uint8 a_col, const uint8 *a_str) {
+	LCD_frameMoveCursor(a_row, a_col);
+	LCD_frameString_P(a_str);
+}
+
+/*
+ * Description: Queues the changed cells for the background writer. Runs of changed cells are
+ * written back to back, the cursor is moved only across more than
+ * LCD_FRAME_MAX_GAP unchanged cells or to another row.
+ * */
+void LCD_frameRefresh(void) {
+	for (uint8 row = 0; row < LCD_MAX_ROWS; row++) {
+		for (uint8 col = 0; g_frame_dirty[row] != 0; col++) {
+			if (!(g_frame_dirty[row] & ((uint16) 1 << col))) {
+				continue;
+			}
+			g_frame_dirty[row] &= ~((uint16) 1 << col);
+			if ((g_lcd_row != row) || (g_lcd_col > col)
+					|| (col - g_lcd_col > LCD_FRAME_MAX_GAP)) {
+				lcd_put(LOGIC_LOW, (g_row_address[row] + col) | LCD_COMMAND_FORCE_CURSOR);
+				g_lcd_row = row;
+				g_lcd_col = col;
+			}
+			/* Unchanged cells of a small gap are rewritten as shown */
+			while (g_lcd_col <= col) {
+				g_shown[row][g_lcd_col] = g_frame[row][g_lcd_col];
+				lcd_put(LOGIC_HIGH, g_shown[row][g_lcd_col]);
+				g_lcd_col++;
+			}
+		}
+	}
+}
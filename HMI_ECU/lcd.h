@@ -18,14 +18,17 @@
 /*******************************************************************************
  *                                Definitions                                  *
  *******************************************************************************/
-/* LCD Data bits mode configuration, its value should be 4 or 8*/
+/* LCD Data bits mode configuration, its value should be 4 or 8
+ * (4 leaves the other half of the data port to the application)*/
+#ifndef LCD_MODE
 #define LCD_MODE 8
+#endif
 /* LCD pin connections, either on first 4 pins (P0-P3) of the port or last 4 pins (P4-P7)*/
 #define LCD_FIRST_4_PINS 1
 #define LCD_LAST_4_PINS  0
 #if((LCD_MODE != 4) && (LCD_MODE != 8))
 
-#error "LCD setup pins should be either first or last port pins ONLY"
+#error "LCD_MODE should be either 4 or 8 ONLY"
 
 #elif ((LCD_FIRST_4_PINS==1) && (LCD_LAST_4_PINS==1)) ||((LCD_FIRST_4_PINS==0) && (LCD_LAST_4_PINS==0))
 
@@ -48,40 +51,91 @@
 #define LCD_ROW_3 3
 /*******LCD commands*********/
 #if (LCD_MODE==4)
-#define LCD_4BIT_MODE LCD_MODE
-#define LCD_COMMAND_CLEAR 		 (0x01)	/* Clear screen command */
-#define LCD_COMMAND_4BIT_INIT	 (0x02)	/* LCD initialization command in for 4 bit mode */
-#define LCD_COMMAND_MODE 		 (0x28)	/* 5x7 2 lines mode */
+#define LCD_COMMAND_MODE 		 (0x28)	/* 4 bit bus, 5x7 2 lines mode */
 #else
-#define LCD_COMMAND_CLEAR 		 (0x01) /* Clear screen command */
-#define LCD_COMMAND_MODE 		 (0x38) /* 5x7 2 lines mode */
+#define LCD_COMMAND_MODE 		 (0x38) /* 8 bit bus, 5x7 2 lines mode */
 #endif
-
+#define LCD_COMMAND_CLEAR 		 (0x01) /* Clear screen command */
+#define LCD_COMMAND_RESET 		 (0x03) /* Upper nibble of an 8 bit bus mode command, resets the bus width */
+#define LCD_COMMAND_4BIT_INIT	 (0x02)	/* Upper nibble of a 4 bit bus mode command, sent once after the reset */
+#define LCD_COMMAND_CGRAM 		 (0x40) /* Set CGRAM address, slot * 8 + pixel row */
+#define LCD_COMMAND_ENTRY_MODE	 (0x06) /* Increment the address after each character, no shift */
+#define LCD_COMMAND_HOME 		 (0x02) /* Return home, with clear the only long (1.52ms) commands */
 #define LCD_COMMAND_CURSOR_BLINK (0x0F) /* Enable cursor blinking */
 #define LCD_COMMAND_FORCE_CURSOR (0x80)	/* Force cursor position at 0,0 */
 #define LCD_COMMAND_CURSOR_OFF 	 (0x0C)	/* Turn off blinking cursor */
 #define LCD_COMMAND_DISPCURS_ON	 (0x0E) /* Display on, cursor on */
 #define LCD_COMMAND_DISPLAY_OFF	 (0x08) /* Turn off display*/
 
+#define LCD_CGRAM_SLOTS 8	/* Custom characters, codes 0-7 (and 8-15) */
+#define LCD_CGRAM_ROWS 8	/* Bytes of a 5x8 custom character */
+
 /*******LCD registers*********/
 #define LCD_REG_COL_0 (0x00)
 #define LCD_REG_COL_1 (0x40)
 #define LCD_REG_COL_2 (0x10)
 #define LCD_REG_COL_3 (0x50)
+
+/*******LCD timing*********/
+#define LCD_BUSY_FLAG (0x80)	/* Status bit 7, the address counter is in bits 0-6 */
+#define LCD_ADDRESS_UNKNOWN (0xFF)
+#define LCD_PULSE_US 1			/* Enable high and low time (230ns/500ns cycle minimum) */
+#define LCD_BUSY_TIMEOUT_US 2000	/* Busy flag polled before falling back to fixed delays */
+#define LCD_DELAY_LONG_MS 2		/* Fallback wait after clear/home (1.52ms) */
+#define LCD_DELAY_SHORT_US 50	/* Fallback wait after other transfers (37us) */
+#define LCD_POWER_ON_MS 40		/* Wait after power on before the reset sequence */
+#define LCD_RESET_FIRST_MS 5	/* Wait after the first reset command (4.1ms) */
+#define LCD_RESET_NEXT_US 100	/* Wait after the next reset commands */
+
+/*******LCD background writer*********/
+#ifndef GPIO_SIM
+#define LCD_QUEUE_ENABLE TRUE	/* Queued bytes are sent by the Timer0 compare ISR */
+#else
+#define LCD_QUEUE_ENABLE FALSE	/* No timers on the host simulation, bytes are sent at once */
+#endif
+#define LCD_QUEUE_SIZE 64		/* Bytes queued at once, power of 2 (a 2x16 screen with its cursor moves) */
+#define LCD_QUEUE_TICK_US 50	/* Period of the ISR, one byte per tick (37us per transfer) */
+
+/*******LCD frame buffer*********/
+#define LCD_FRAME_MAX_GAP 1	/* Clean cells rewritten instead of moving the cursor (a move costs one command) */
 /*******************************************************************************
  *                              Functions Prototypes                           *
  *******************************************************************************/
 /*Description: Initializes the LCD data bus & control pins
  * according to the pre-dfined preprocessor definitions
+ * In 4 bit mode the bus is written with the PORT & DDR bits the other 4 pins
+ * of LCD_DATA_PORT had here, never read back, also from the Timer0 ISR. After
+ * this function those pins must only be changed through LCD_writeOtherPins and
+ * LCD_setupOtherPinsDirection, a direct write is reverted by the next transfer.
  * */
 void LCD_init(void);
 
+/*Description: Writes the bits of a_value selected by a_mask on the pins of
+ * LCD_DATA_PORT not used by the bus (none in 8 bit mode, other bits of a_mask
+ * are ignored). Safe against the background writer, not to be called from an
+ * ISR.
+ * */
+void LCD_writeOtherPins(uint8 a_mask, uint8 a_value);
+
+/*Description: Sets the direction of the pins of LCD_DATA_PORT not used by the
+ * bus selected by a_mask, like LCD_writeOtherPins.
+ * */
+void LCD_setupOtherPinsDirection(uint8 a_mask, uint8 a_direction);
+
 /*Description: Sends a command to the LCD as given by a_data */
 void LCD_sendCommand(uint8 a_data);
 
 /*Description: Displays a single character given by a_char */
 void LCD_displayCharacter(uint8 a_char);
 
+/*
+ * Description: Returns the address counter of the LCD (cursor address) once it
+ * is ready. The transfers wait on the LCD busy flag instead of fixed delays, if
+ * it cannot be read (R/W not wired) they fall back to the worst case delays and
+ * this function returns LCD_ADDRESS_UNKNOWN.
+ * */
+uint8 LCD_getAddress(void);
+
 /*Description: Displays a string on the LCD from a character array
  * If the number of characters overflow the maximum LCD columns,
  * the function will print from the current cursor position until end of row only
@@ -102,6 +156,13 @@ void LCD_moveCursor(uint8 a_row, uint8 a_col);
  * */
 void LCD_displayStringRowColumn(uint8 a_row, uint8 a_col, const uint8 *a_str);
 
+/*
+ * Description: LCD_displayString / LCD_displayStringRowColumn for a string in
+ * program memory (PROGMEM), read byte by byte without an SRAM copy
+ * */
+void LCD_displayString_P(const uint8 *a_str);
+void LCD_displayStringRowColumn_P(uint8 a_row, uint8 a_col, const uint8 *a_str);
+
 /*
  * Description: Clears the LCD by sending the Clear command to the LCD
  * */
@@ -115,4 +176,72 @@ void LCD_clearScreen(void);
 
 void LCD_integerToString(int a_data);
 
+/*
+ * Background writer:
+ * The LCD_queue* functions return at once, the bytes are sent one per
+ * LCD_QUEUE_TICK_US by the Timer0 compare ISR when the LCD is ready. Timer0
+ * only runs while bytes are queued. A full queue waits for room, so they must
+ * not be called with interrupts disabled. The functions above wait until the
+ * queue is empty before writing.
+ * */
+
+/*Description: Queues a command for the background writer */
+void LCD_queueCommand(uint8 a_data);
+
+/*Description: Queues a character for the background writer */
+void LCD_queueCharacter(uint8 a_char);
+
+/*Description: Queues a string for the background writer */
+void LCD_queueString(const uint8 *a_str);
+
+/*
+ * Description: Queues the upload of a custom character to a CGRAM slot from
+ * LCD_CGRAM_ROWS bytes in program memory (bits 4-0 of each pixel row). The
+ * next frame refresh moves the cursor back to the display RAM.
+ * */
+void LCD_defineCharacter_P(uint8 a_slot, const uint8 *a_pattern);
+
+/*Description: Returns TRUE once every queued byte was sent */
+boolean LCD_isIdle(void);
+
+/*Description: Waits until every queued byte was sent */
+void LCD_flush(void);
+
+/*
+ * Frame buffer:
+ * The LCD_frame* functions draw into a RAM copy of the display and
+ * LCD_frameRefresh() sends only the cells that differ from what the LCD shows,
+ * so a screen can be cleared and redrawn every time at the cost of its changes.
+ * Both copies are reset by LCD_init(), direct writes with the functions above
+ * are not tracked and should not be mixed with the frame buffer.
+ * */
+
+/*Description: Fills the frame with spaces and moves the frame cursor to 0,0 */
+void LCD_frameClear(void);
+
+/*Description: Moves the frame cursor, out of range positions are ignored */
+void LCD_frameMoveCursor(uint8 a_row, uint8 a_col);
+
+/*Description: Writes a character at the frame cursor and advances it,
+ * nothing is written past the end of the row
+ * */
+void LCD_frameCharacter(uint8 a_char);
+
+/*Description: Writes a string from the frame cursor until its end or the end of the row */
+void LCD_frameString(const uint8 *a_str);
+
+/*Description: Writes a string from the given row and column of the frame */
+void LCD_frameStringRowColumn(uint8 a_row, uint8 a_col, const uint8 *a_str);
+
+/*Description: LCD_frameString / LCD_frameStringRowColumn for a string in program memory */
+void LCD_frameString_P(const uint8 *a_str);
+void LCD_frameStringRowColumn_P(uint8 a_row, uint8 a_col, const uint8 *a_str);
+
+/*
+ * Description: Queues the changed cells for the background writer. Runs of changed cells are
+ * written back to back, the cursor is moved only across more than
+ * LCD_FRAME_MAX_GAP unchanged cells or to another row.
+ * */
+void LCD_frameRefresh(void);
+
 #endif /* LCD_H_ */
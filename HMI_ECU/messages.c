@@ -0,0 +1,59 @@
+/******************************************************************************
+ *
+ * Module: Messages
+ *
+ * File Name: messages.c
+ *
+ * Description: Source file for the HMI user interface strings.
+ *
+ * Date Created: 18/10/2026
+ *
+ * Author: Hazem Montasser
+ *
+ *******************************************************************************/
+
+#include "messages.h"
+#include <avr/pgmspace.h>
+
+/*******************************************************************************
+ *                         Global Variables(Private)                           *
+ *******************************************************************************/
+
+#if (MESSAGES_LANGUAGE == MESSAGES_LANGUAGE_EN)
+static const uint8 g_please_enter[] PROGMEM = "Please enter";
+static const uint8 g_please_reenter[] PROGMEM = "Please re-enter";
+static const uint8 g_new_pass[] PROGMEM = "new pass: ";
+static const uint8 g_open_door[] PROGMEM = "+ : Open door";
+static const uint8 g_change_pass[] PROGMEM = "- : Change pass";
+static const uint8 g_enter_pass[] PROGMEM = "Enter pass: ";
+static const uint8 g_error[] PROGMEM = "   !!!ERROR!!!";
+static const uint8 g_unlocking[] PROGMEM = "unlocking...";
+static const uint8 g_locking[] PROGMEM = "locking...";
+#else
+#error "MESSAGES_LANGUAGE has no table"
+#endif
+
+/* Indexed by Message_IdType, the table itself is in flash too */
+static const uint8 *const g_messages[MESSAGE_COUNT] PROGMEM = {
+		g_please_enter,
+		g_please_reenter,
+		g_new_pass,
+		g_open_door,
+		g_change_pass,
+		g_enter_pass,
+		g_error,
+		g_unlocking,
+		g_locking };
+
+static const uint8 g_empty[] PROGMEM = "";
+
+/*******************************************************************************
+ *                              Functions Definitions                          *
+ *******************************************************************************/
+
+const uint8* Message_get(Message_IdType a_id) {
+	if (a_id >= MESSAGE_COUNT) {
+		return g_empty;
+	}
+	return (const uint8*) pgm_read_ptr(&g_messages[a_id]);
+}
@@ -0,0 +1,75 @@
+/******************************************************************************
+ *
+ * Module: Messages
+ *
+ * File Name: messages.h
+ *
+ * Description: Header file for the HMI user interface strings.
+ *
+ * 				Every string shown by the HMI is kept in flash (PROGMEM) and
+ * 				looked up by its message ID, so none of them is copied to SRAM
+ * 				through .data at startup. Message_get returns a program memory
+ * 				pointer for the LCD _P functions (see lcd.h).
+ *
+ * 				The table of the language selected by MESSAGES_LANGUAGE is the
+ * 				only one built, another language is one more table in messages.c
+ * 				with the same IDs.
+ *
+ * Date Created: 18/10/2026
+ *
+ * Author: Hazem Montasser
+ *
+ *******************************************************************************/
+
+#ifndef MESSAGES_H_
+#define MESSAGES_H_
+
+#include "std_types.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define MESSAGES_LANGUAGE_EN 	(0U)
+#define MESSAGES_LANGUAGE 		MESSAGES_LANGUAGE_EN	/* Language built in */
+
+/*******************************************************************************
+ *                               Types Declaration                             *
+ *******************************************************************************/
+
+/* Message IDs, index of the language tables */
+typedef enum {
+	MESSAGE_PLEASE_ENTER,
+	MESSAGE_PLEASE_REENTER,
+	MESSAGE_NEW_PASS,
+	MESSAGE_OPEN_DOOR,
+	MESSAGE_CHANGE_PASS,
+	MESSAGE_ENTER_PASS,
+	MESSAGE_ERROR,
+	MESSAGE_UNLOCKING,
+	MESSAGE_LOCKING,
+	MESSAGE_COUNT
+} Message_IdType;
+
+/*******************************************************************************
+ *                              Functions Prototypes                           *
+ *******************************************************************************/
+
+/******************************************************************************
+ *
+ * Function Name: Message_get
+ *
+ * Description: Returns the program memory address of a message.
+ *
+ * Args:
+ *
+ * 		[in] Message_IdType a_id
+ * 			Message to look up, less than MESSAGE_COUNT.
+ * 		[out] N/A
+ * Returns: const uint8* (program memory)
+ * 		Address of the null terminated string, an empty string for an invalid ID.
+ *
+ *******************************************************************************/
+const uint8* Message_get(Message_IdType a_id);
+
+#endif /* MESSAGES_H_ */
@@ -0,0 +1,462 @@
+/******************************************************************************
+ *
+ * Module: Timer
+ *
+ * File Name: timer.h
+ *
+ * Description: Header file for the AVR Timers driver
+ *
+ * Date Created: 18/10/2021
+ *
+ * Author: Hazem Montasser
+ *
+ *******************************************************************************/
+
+#ifndef TIMER_H_
+#define TIMER_H_
+#include "std_types.h"
+
+/*******************************************************************************
+ *                                Types Declarations                           *
+ *******************************************************************************/
+/* Timer ID's for AVR Atmega16 */
+typedef enum {
+	TIMER0_ID, TIMER1_ID, TIMER2_ID
+} Timer_ID;
+/* Clock pre-scalers for Timers 0 & 1*/
+typedef enum {
+	NO_CLOCK_T01,
+	FCPU_1_T01,
+	FCPU_8_T01,
+	FCPU_64_T01,
+	FCPU_256_T01,
+	FCPU_1024_T01,
+	XTAL_T0_FALLING_T01,
+	XTAL_T0_RISING_T01
+} Timer01_Clock;
+
+/* Clock pre-scalers for Timer 2*/
+typedef enum {
+	NO_CLOCK_T2,
+	FCPU_1_T2,
+	FCPU_8_T2,
+	FCPU_32_T2,
+	FCPU_64_T2,
+	FCPU_128_T2,
+	FCPU_256_T2,
+	FCPU_1024_T2,
+
+} Timer2_Clock;
+
+/* Timer modes used to set certain bits in registers and load OCR values
+ * 	PWM modes: Timers 0 & 2 count to 0xFF, Timer1 to 0x3FF (10-bit) so that
+ * 	ICR1 stays free for input capture.
+ * */
+typedef enum {
+	Timer_Mode_Normal, Timer_Mode_Compare, Timer_Mode_FastPWM, Timer_Mode_PhaseCorrectPWM
+} Timer_Mode;
+
+/* Behavior of the OC pin on compare match, written to the COM bits
+ * 	Non-PWM modes: toggle/clear/set the pin on every match
+ * 	PWM modes: CLEAR = non-inverting, SET = inverting (TOGGLE is reserved)
+ * 	---Note: The OC pin must be set as output through the GPIO driver.
+ * */
+typedef enum {
+	Timer_Output_Disconnected, Timer_Output_Toggle, Timer_Output_Clear, Timer_Output_Set
+} Timer_OutputMode;
+
+/* Interrupt sources, each one has its own callback */
+typedef enum {
+	TIMER0_OVF_SOURCE,
+	TIMER0_COMP_SOURCE,
+	TIMER1_OVF_SOURCE,
+	TIMER1_COMPA_SOURCE,
+	TIMER1_COMPB_SOURCE,
+	TIMER1_CAPT_SOURCE,
+	TIMER2_OVF_SOURCE,
+	TIMER2_COMP_SOURCE,
+	TIMER_SOURCES_COUNT
+} Timer_Source;
+
+/* Timer1 input capture edge on ICP1 pin */
+typedef enum {
+	Timer_Edge_Falling, Timer_Edge_Rising
+} Timer_Edge;
+
+/******************************************************************************
+ *
+ * Structure Name: Timer_ConfigType
+ *
+ * Structure Description: Structure responsible for configuring all 3 timers in
+ *  Atmega16 uC.
+ *
+ *******************************************************************************/
+typedef struct {
+	uint8 Timer_ID; /* Timer ID: 0, 1 ,2*/
+	uint8 Prescaler; /* Timer pre-scaler value */
+	Timer_Mode Mode; /* Normal, compare (CTC) or PWM mode*/
+	uint16 Compare_Value; /* Compare value: OCR0/OCR1A/OCR2, duty cycle in PWM modes */
+	boolean Interrupt_Enable;/* Enable/disable interrupt: compare in CTC mode, overflow otherwise*/
+	uint16 Compare_B_Value; /* Timer1 only: OCR1B */
+	Timer_OutputMode Output; /* OC0/OC1A/OC2 pin behavior */
+	Timer_OutputMode Output_B; /* Timer1 only: OC1B pin behavior */
+} Timer_ConfigType;
+
+/*******************************************************************************
+ *                       Compile-time Period Solver                            *
+ *******************************************************************************/
+/*
+ * Given F_CPU, a timer ID and a period in microseconds, these macros pick the
+ * pre-scaler and compare value for a Timer_Mode_Compare (CTC) timer at compile
+ * time, no division or float code is left for run time.
+ *
+ * Every pre-scaler divides the next bigger one (1, 8, [32,] 64, [128,] 256, 1024),
+ * so the periods reachable with a big pre-scaler are also reachable with any
+ * smaller one. The smallest pre-scaler whose count fits the timer is then the
+ * one with the least error, and also the finest resolution.
+ *
+ * Usage:
+ * 		TIMER_PERIOD_ASSERT(TIMER2_ID, 1000UL, systick);
+ * 		Timer_ConfigType config = TIMER_CONFIG_PERIOD(TIMER2_ID, 1000UL, TRUE);
+ */
+
+/* Timer counts (compare value + 1) for a_us at a_div, rounded to nearest */
+#define TIMER_PERIOD_COUNTS(a_us, a_div) \
+	((((unsigned long long) (F_CPU) * (a_us)) + ((a_div) * 500000ULL)) \
+			/ ((a_div) * 1000000ULL))
+
+/* Non-zero if a_us can be generated at a_div on a timer with a_top counts */
+#define TIMER_PERIOD_FITS(a_us, a_div, a_top) \
+	((TIMER_PERIOD_COUNTS(a_us, a_div) >= 1ULL) \
+			&& (TIMER_PERIOD_COUNTS(a_us, a_div) <= (a_top)))
+
+/* Counts of the timer: 16-bit Timer1, 8-bit Timers 0 & 2 */
+#define TIMER_TOP_COUNTS(a_id)		((a_id) == TIMER1_ID ? 65536ULL : 256ULL)
+
+/* Smallest pre-scaler division that fits, 0 if the period can't be reached */
+#define TIMER01_PERIOD_DIVISOR(a_us, a_top) \
+	(TIMER_PERIOD_FITS(a_us, 1ULL, a_top) ? 1ULL : \
+	 TIMER_PERIOD_FITS(a_us, 8ULL, a_top) ? 8ULL : \
+	 TIMER_PERIOD_FITS(a_us, 64ULL, a_top) ? 64ULL : \
+	 TIMER_PERIOD_FITS(a_us, 256ULL, a_top) ? 256ULL : \
+	 TIMER_PERIOD_FITS(a_us, 1024ULL, a_top) ? 1024ULL : 0ULL)
+
+#define TIMER2_PERIOD_DIVISOR(a_us) \
+	(TIMER_PERIOD_FITS(a_us, 1ULL, 256ULL) ? 1ULL : \
+	 TIMER_PERIOD_FITS(a_us, 8ULL, 256ULL) ? 8ULL : \
+	 TIMER_PERIOD_FITS(a_us, 32ULL, 256ULL) ? 32ULL : \
+	 TIMER_PERIOD_FITS(a_us, 64ULL, 256ULL) ? 64ULL : \
+	 TIMER_PERIOD_FITS(a_us, 128ULL, 256ULL) ? 128ULL : \
+	 TIMER_PERIOD_FITS(a_us, 256ULL, 256ULL) ? 256ULL : \
+	 TIMER_PERIOD_FITS(a_us, 1024ULL, 256ULL) ? 1024ULL : 0ULL)
+
+#define TIMER_PERIOD_DIVISOR(a_id, a_us) \
+	((a_id) == TIMER2_ID ? TIMER2_PERIOD_DIVISOR(a_us) \
+			: TIMER01_PERIOD_DIVISOR(a_us, TIMER_TOP_COUNTS(a_id)))
+
+/* Timer01_Clock / Timer2_Clock value of a pre-scaler division */
+#define TIMER01_CLOCK_OF(a_div) \
+	((a_div) == 1ULL ? FCPU_1_T01 : \
+	 (a_div) == 8ULL ? FCPU_8_T01 : \
+	 (a_div) == 64ULL ? FCPU_64_T01 : \
+	 (a_div) == 256ULL ? FCPU_256_T01 : \
+	 (a_div) == 1024ULL ? FCPU_1024_T01 : NO_CLOCK_T01)
+
+#define TIMER2_CLOCK_OF(a_div) \
+	((a_div) == 1ULL ? FCPU_1_T2 : \
+	 (a_div) == 8ULL ? FCPU_8_T2 : \
+	 (a_div) == 32ULL ? FCPU_32_T2 : \
+	 (a_div) == 64ULL ? FCPU_64_T2 : \
+	 (a_div) == 128ULL ? FCPU_128_T2 : \
+	 (a_div) == 256ULL ? FCPU_256_T2 : \
+	 (a_div) == 1024ULL ? FCPU_1024_T2 : NO_CLOCK_T2)
+
+/* Pre-scaler and compare value to load in Timer_ConfigType */
+#define TIMER_PERIOD_PRESCALER(a_id, a_us) \
+	((uint8) ((a_id) == TIMER2_ID \
+			? TIMER2_CLOCK_OF(TIMER_PERIOD_DIVISOR(a_id, a_us)) \
+			: TIMER01_CLOCK_OF(TIMER_PERIOD_DIVISOR(a_id, a_us))))
+
+#define TIMER_PERIOD_COMPARE(a_id, a_us) \
+	((uint16) (TIMER_PERIOD_COUNTS(a_us, TIMER_PERIOD_DIVISOR(a_id, a_us)) - 1ULL))
+
+/* Time of one timer count in microseconds (integer when F_CPU allows it) */
+#define TIMER_PERIOD_US_PER_COUNT(a_id, a_us) \
+	(TIMER_PERIOD_DIVISOR(a_id, a_us) * 1000000ULL / (F_CPU))
+
+/* Fails the build (negative array size) if a_us can't be reached on a_id */
+#define TIMER_PERIOD_ASSERT(a_id, a_us, a_tag) \
+	typedef char timer_period_unreachable_##a_tag \
+			[(TIMER_PERIOD_DIVISOR(a_id, a_us) != 0ULL) ? 1 : -1]
+
+/* Complete Timer_ConfigType initializer for a periodic compare timer */
+#define TIMER_CONFIG_PERIOD(a_id, a_us, a_interrupt) \
+	{ (a_id), TIMER_PERIOD_PRESCALER(a_id, a_us), Timer_Mode_Compare, \
+			TIMER_PERIOD_COMPARE(a_id, a_us), (a_interrupt) }
+
+/*******************************************************************************
+ *                           Functions Prototypes                              *
+ *******************************************************************************/
+
+
+/******************************************************************************
+ *
+ * Function Name: Timer_init
+ *
+ * Description:  Timer responsible for initializing AND starting any of the 3 timers
+ * in Atmega16.
+ * 		-If Mode in Timer_ConfigType is set to Timer_Mode_Normal, Compare_Value is ignored.
+ * 		-In PWM modes Compare_Value is the duty cycle, out of 0xFF (Timers 0 & 2)
+ * 		 or 0x3FF (Timer1).
+ * 		-Compare_B_Value & Output_B are only used by Timer1.
+ * 		-Prescaler MUST be compatible with the Timer_ID chosen, see Timer clock enums.
+ *
+ * Args:
+ *
+ * 		[in] const Timer_ConfigType *Config
+ * 			Pointer to structure which contains all needed configuration parameters
+ * 			for timer.
+ * 		[out] N/A
+ * Returns: void
+ *
+ *******************************************************************************/
+void Timer_init(const Timer_ConfigType *Config);
+
+
+/******************************************************************************
+ *
+ * Function Name: Timer_setCallback
+ *
+ * Description:  Function responsible for setting the callback notification
+ * 			for the selected timer, on both its overflow and compare (A) sources.
+ * 		---Note: Use Timer_setSourceCallback to share a timer between users.
+ *
+ * Args:
+ *
+ * 		[in] uint8 a_Timer_ID
+				Timer ID  (0,1,2)
+ * 			void (*a_ptrToCallback)(void)
+ * 				Pointer to the callback function provided.
+ * 		[out] N/A
+ * Returns: void
+ *
+ *******************************************************************************/
+void Timer_setCallback(uint8 a_Timer_ID, void (*a_ptrToCallback)(void));
+
+
+/******************************************************************************
+ *
+ * Function Name: Timer_setSourceCallback
+ *
+ * Description:  Sets the callback notification of a single interrupt source,
+ * 			other sources of the same timer keep their own callbacks.
+ *
+ * Args:
+ *
+ * 		[in] Timer_Source a_source
+ *				Interrupt source, see Timer_Source enum
+ * 			void (*a_ptrToCallback)(void)
+ * 				Pointer to the callback function provided.
+ * 		[out] N/A
+ * Returns: void
+ *
+ *******************************************************************************/
+void Timer_setSourceCallback(Timer_Source a_source, void (*a_ptrToCallback)(void));
+
+
+/******************************************************************************
+ *
+ * Function Name: Timer_enableInterrupt
+ *
+ * Description:  Enables the interrupt of a single source in TIMSK, used for the
+ * 			sources not covered by Interrupt_Enable (COMPB, input capture).
+ *
+ * Args:
+ *
+ * 		[in] Timer_Source a_source
+ *				Interrupt source, see Timer_Source enum
+ * 		[out] N/A
+ * Returns: void
+ *
+ *******************************************************************************/
+void Timer_enableInterrupt(Timer_Source a_source);
+
+
+/******************************************************************************
+ *
+ * Function Name: Timer_disableInterrupt
+ *
+ * Description:  Disables the interrupt of a single source in TIMSK.
+ *
+ * Args:
+ *
+ * 		[in] Timer_Source a_source
+ *				Interrupt source, see Timer_Source enum
+ * 		[out] N/A
+ * Returns: void
+ *
+ *******************************************************************************/
+void Timer_disableInterrupt(Timer_Source a_source);
+
+
+/******************************************************************************
+ *
+ * Function Name: Timer_setCompareValue
+ *
+ * Description:  Sets the compare value in OCR register to a_CompareVal according
+ * 				to the selected timer.
+ *
+ * Args:
+ *
+ * 		[in] uint8 a_Timer_ID
+ *				Timer ID  (0,1,2)
+ *			uint16 a_CompareVal
+ *				New compare value to set in OCR register
+ * 		[out] N/A
+ * Returns: void
+ *
+ *******************************************************************************/
+void Timer_setCompareValue(uint8 a_Timer_ID, uint16 a_CompareVal);
+
+
+/******************************************************************************
+ *
+ * Function Name: Timer_setCompareBValue
+ *
+ * Description:  Sets a new compare value in OCR1B (Timer1 channel B).
+ *
+ * Args:
+ *
+ *		[in] uint16 a_CompareVal
+ *				New compare value to set in OCR1B register
+ * 		[out] N/A
+ * Returns: void
+ *
+ *******************************************************************************/
+void Timer_setCompareBValue(uint16 a_CompareVal);
+
+
+/******************************************************************************
+ *
+ * Function Name: Timer_setCaptureEdge
+ *
+ * Description:  Selects the ICP1 edge which copies TCNT1 into ICR1, the noise
+ * 			canceler adds a 4 cycle delay but filters spikes.
+ * 		---Note: Call after Timer_init, which clears TCCR1B.
+ *
+ * Args:
+ *
+ *		[in] Timer_Edge a_edge
+ *				Falling or rising edge
+ *			 boolean a_noiseCanceler
+ *				TRUE to enable the input capture noise canceler
+ * 		[out] N/A
+ * Returns: void
+ *
+ *******************************************************************************/
+void Timer_setCaptureEdge(Timer_Edge a_edge, boolean a_noiseCanceler);
+
+
+/******************************************************************************
+ *
+ * Function Name: Timer_getCaptureValue
+ *
+ * Description:  Returns the TCNT1 value latched in ICR1 at the last capture.
+ *
+ * Args: void
+ *
+ * Returns: uint16
+ *
+ *******************************************************************************/
+uint16 Timer_getCaptureValue(void);
+
+
+/******************************************************************************
+ *
+ * Function Name: Timer_getTimerValue
+ *
+ * Description:  Returns the current timer value
+ *
+ * Args:
+ *
+ * 		[in] uint8 a_Timer_ID
+ *				Timer ID  (0,1,2)
+ * 		[out] N/A
+ *
+ * Returns: uint16
+ *
+ *******************************************************************************/
+uint16 Timer_getTimerValue(uint8 a_Timer_ID);
+
+
+/******************************************************************************
+ *
+ * Function Name: Timer_stop
+ *
+ * Description:  Stops/pauses timer by changing the pre-scaler bits to 000.
+ *		---Note: Does NOT clear timer register value.
+ * Args:
+ *
+ * 		[in] uint8 a_Timer_ID
+				Timer ID  (0,1,2)
+ * 		[out] N/A
+ *
+ * Returns: void
+ *
+ *******************************************************************************/
+void Timer_stop(uint8 a_Timer_ID);
+
+
+/******************************************************************************
+ *
+ * Function Name: Timer_resume
+ *
+ * Description:  Resumes the timer by restoring the original pre-scaler bits.
+ * 		---Note: Does NOT clear timer register value before resuming.
+ * Args:
+ *
+ * 		[in] uint8 a_Timer_ID
+				Timer ID  (0,1,2)
+ * 		[out] N/A
+ *
+ * Returns: void
+ *
+ *******************************************************************************/
+void Timer_resume(uint8 a_Timer_ID);
+
+
+/******************************************************************************
+ *
+ * Function Name: Timer_resetTimerValue
+ *
+ * Description:  Resets timer counter register value according to selected timer.
+ *
+ * Args:
+ *
+ * 		[in] uint8 a_Timer_ID
+				Timer ID  (0,1,2)
+ * 		[out] N/A
+ * Returns: void
+ *
+ *******************************************************************************/
+void Timer_resetTimerValue(uint8 a_Timer_ID);
+
+
+/******************************************************************************
+ *
+ * Function Name: Timer_DeInit
+ *
+ * Description:  De-initializes selected timer by clearing its counter, control
+ * & OCR registers AND turns off both Timer overflow & Timer compare interrupts.
+ * 		---Note: TIMSK bits are preserved, only the needed bits are zero'd.
+ *
+ * Args:
+ *
+ * 		[in] uint8 a_Timer_ID
+ *				Timer ID  (0,1,2)
+ * 		[out] N/A
+ * Returns: void
+ *
+ *******************************************************************************/
+void Timer_DeInit(uint8 a_Timer_ID);
+#endif /* TIMER_H_ */
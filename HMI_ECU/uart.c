@@ -14,25 +14,44 @@
 
 #include "uart.h"
 #include "common_macros.h"
+#include "profiler.h"
 #include <avr/io.h>
 #include <avr/interrupt.h>
 /*******************************************************************************
  *                                Global Variables (Private)                   *
  *******************************************************************************/
-static volatile void (*g_UART_TXC_Callback) = NULL_PTR;
-static volatile void (*g_UART_RXC_Callback) = NULL_PTR;
-static volatile void (*g_UART_UDRE_Callback) = NULL_PTR;
+static void (*volatile g_UART_TXC_Callback)(void) = NULL_PTR;
+static void (*volatile g_UART_RXC_Callback)(void) = NULL_PTR;
+static void (*volatile g_UART_UDRE_Callback)(void) = NULL_PTR;
+static void (*g_UART_Idle_Callback)(void) = NULL_PTR;
+
+volatile uint16 g_UART_RX_data = 0;
+
+#if (RX_INTERRUPT_ENABLE==TRUE)
+/* Bytes received by the RXC ISR and not read yet (ring) */
+static volatile uint8 g_UART_RX_buffer[UART_RX_BUFFER_SIZE];
+static volatile uint8 g_UART_RX_head = 0; /* Written by the ISR */
+static volatile uint8 g_UART_RX_tail = 0; /* Written by the readers */
+#endif
 /*******************************************************************************
  *                                ISR's Definitions                            *
  *******************************************************************************/
 #if (RX_INTERRUPT_ENABLE==TRUE)
 ISR(USART_RXC_vect) {
+	PROFILE_BEGIN(PROBE_ISR_UART_RXC);
+	uint8 next = (g_UART_RX_head + 1) & (UART_RX_BUFFER_SIZE - 1);
+	/* Store incoming data into global variable */
+	g_UART_RX_data = UDR;
+	/* Buffer it, a byte arriving while the ring is full is dropped */
+	if (next != g_UART_RX_tail) {
+		g_UART_RX_buffer[g_UART_RX_head] = g_UART_RX_data;
+		g_UART_RX_head = next;
+	}
 	/* Invoke call to callback function */
 	if (g_UART_RXC_Callback != NULL_PTR) {
 		(*g_UART_RXC_Callback)();
 	}
-	/* Store incoming data into global variable */
-	g_UART_RX_data = UDR;
+	PROFILE_END(PROBE_ISR_UART_RXC);
 }
 #endif
 #if (TX_INTERRUPT_ENABLE==TRUE)
@@ -101,20 +120,60 @@ void UART_init(UART_ConfigType *Config) {
 	UBRRL = ubrr_value;
 }
 void UART_sendByte(uint8 a_data) {
+	(void) UART_sendByteTimeout(a_data, TIMEOUT_FOREVER);
+}
+
+Timeout_StatusType UART_sendByteTimeout(uint8 a_data,
+		const Timeout_DeadlineType *a_deadline) {
 	/* Poll until UDR register is empty*/
-	while (BIT_IS_CLEAR(UCSRA, UDRE))
-		;
+	while (BIT_IS_CLEAR(UCSRA, UDRE)) {
+		if (Timeout_check(a_deadline, TIMEOUT_SITE_UART_TX)
+				!= TIMEOUT_STATUS_OK) {
+			return TIMEOUT_STATUS_EXPIRED;
+		}
+	}
 
 	/* Send data */
 	UDR = a_data;
+	return TIMEOUT_STATUS_OK;
 }
 uint8 UART_receiveByte(void) {
-	/* Poll until byte is received */
-	while (BIT_IS_CLEAR(UCSRA, RXC))
-		;
+	uint8 data;
+	(void) UART_receiveByteTimeout(&data, TIMEOUT_FOREVER);
+	return data;
+}
+
+Timeout_StatusType UART_receiveByteTimeout(uint8 *a_data,
+		const Timeout_DeadlineType *a_deadline) {
+	/* Poll until byte is received, running idle work meanwhile */
+	while (!UART_tryReceiveByte(a_data)) {
+		if (Timeout_check(a_deadline, TIMEOUT_SITE_UART_RX)
+				!= TIMEOUT_STATUS_OK) {
+			return TIMEOUT_STATUS_EXPIRED;
+		}
+		if (g_UART_Idle_Callback != NULL_PTR) {
+			(*g_UART_Idle_Callback)();
+		}
+	}
+	return TIMEOUT_STATUS_OK;
+}
 
+boolean UART_tryReceiveByte(uint8 *a_data) {
+#if (RX_INTERRUPT_ENABLE==TRUE)
+	/* Single reader & single writer: the indices need no locking */
+	if (g_UART_RX_tail == g_UART_RX_head) {
+		return FALSE;
+	}
+	*a_data = g_UART_RX_buffer[g_UART_RX_tail];
+	g_UART_RX_tail = (g_UART_RX_tail + 1) & (UART_RX_BUFFER_SIZE - 1);
+#else
+	if (BIT_IS_CLEAR(UCSRA, RXC)) {
+		return FALSE;
+	}
 	/* RXC flag is cleared once UDR register is read */
-	return UDR;
+	*a_data = UDR;
+#endif
+	return TRUE;
 }
 
 void UART_sendString(uint8 *str) {
@@ -127,14 +186,26 @@ void UART_sendString(uint8 *str) {
 
 }
 void UART_receiveString(uint8 *str) {
+	(void) UART_receiveStringTimeout(str, TIMEOUT_FOREVER);
+}
+
+Timeout_StatusType UART_receiveStringTimeout(uint8 *str,
+		const Timeout_DeadlineType *a_deadline) {
 	uint8 i = 0;
+	Timeout_StatusType status;
+	PROFILE_BEGIN(PROBE_UART_RECEIVE_STRING);
 	/* Receive each byte until pre-defined End of string character */
-	do {
-		str[i] = UART_receiveByte();
+	for (;;) {
+		status = UART_receiveByteTimeout(&str[i], a_deadline);
+		if (status != TIMEOUT_STATUS_OK || str[i] == UART_EOS) {
+			break;
+		}
 		i++;
-	} while (str[i] != UART_EOS);
-	/* Add null terminator to string*/
+	}
+	/* Replace end of string character (or end a partial string) with null terminator */
 	str[i] = '\0';
+	PROFILE_END(PROBE_UART_RECEIVE_STRING);
+	return status;
 }
 
 void UART_setTXCallback_Notif(void (*a_callBackNotif_ptr)(void)) {
@@ -146,6 +217,9 @@ void UART_setRXCallback_Notif(void (*a_callBackNotif_ptr)(void)) {
 void UART_setUDRECallback_Notif(void (*a_callBackNotif_ptr)(void)) {
 	g_UART_UDRE_Callback = a_callBackNotif_ptr;
 }
+void UART_setIdleCallback_Notif(void (*a_callBackNotif_ptr)(void)) {
+	g_UART_Idle_Callback = a_callBackNotif_ptr;
+}
 void UART_DeInit(void) {
 	UCSRA = UCSRB = UCSRC = 0;
 
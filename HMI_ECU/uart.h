@@ -15,6 +15,7 @@
 #ifndef UART_H_
 #define UART_H_
 #include "std_types.h"
+#include "timeout.h"
 #include <avr/io.h>
 /*******************************************************************************
  *                                Definitions                                  *
@@ -27,10 +28,12 @@
 #define UART_SET_CHAR_SIZE(size)  UCSRB|=((size)&0x04),\
 UCSRC|=(1<<URSEL)|((size&0x03)<<1)\
 
-#define RX_INTERRUPT_ENABLE   FALSE
+#define RX_INTERRUPT_ENABLE   TRUE	/* Received bytes are buffered by the RXC ISR */
 #define TX_INTERRUPT_ENABLE   FALSE
 #define UDRE_INTERRUPT_ENABLE FALSE
 
+#define UART_RX_BUFFER_SIZE	  (16U)	/* RX ring size, power of 2 */
+
 /*******************************************************************************
  *                               Global Variables                              *
  *******************************************************************************/
@@ -106,6 +109,26 @@ void UART_init(UART_ConfigType *Config);
  *******************************************************************************/
 void UART_sendByte(uint8 a_data);
 
+/******************************************************************************
+ *
+ * Function Name: UART_sendByteTimeout
+ *
+ * Description: Same as UART_sendByte, gives up if UDR is still full at the
+ * 		deadline.
+ *
+ * Args:
+ *
+ * 		[in] a_data
+ * 			Actual byte to send
+ * 			 const Timeout_DeadlineType *a_deadline
+ * 			Deadline, TIMEOUT_FOREVER to wait without bound
+ * 		[out] N/A
+ * Returns: Timeout_StatusType
+ *
+ *******************************************************************************/
+Timeout_StatusType UART_sendByteTimeout(uint8 a_data,
+		const Timeout_DeadlineType *a_deadline);
+
 /******************************************************************************
  *
  * Function Name: UART_receiveByte
@@ -119,6 +142,43 @@ void UART_sendByte(uint8 a_data);
  *******************************************************************************/
 uint8 UART_receiveByte(void);
 
+/******************************************************************************
+ *
+ * Function Name: UART_receiveByteTimeout
+ *
+ * Description: Same as UART_receiveByte, gives up if no byte arrives before
+ * 		the deadline.
+ *
+ * Args:
+ *
+ * 		[in] const Timeout_DeadlineType *a_deadline
+ * 			Deadline, TIMEOUT_FOREVER to wait without bound
+ * 		[out] uint8 *a_data
+ * 			Received byte, untouched on timeout.
+ *
+ * Returns: Timeout_StatusType
+ *
+ *******************************************************************************/
+Timeout_StatusType UART_receiveByteTimeout(uint8 *a_data,
+		const Timeout_DeadlineType *a_deadline);
+
+/******************************************************************************
+ *
+ * Function Name: UART_tryReceiveByte
+ *
+ * Description: Takes a received byte if one is available, without waiting.
+ *
+ * Args:
+ *
+ * 		[in] N/A
+ * 		[out] uint8 *a_data
+ * 			Received byte, untouched if none.
+ *
+ * Returns: boolean (TRUE if a byte was received)
+ *
+ *******************************************************************************/
+boolean UART_tryReceiveByte(uint8 *a_data);
+
 /******************************************************************************
  *
  * Function Name: UART_sendString
@@ -153,6 +213,26 @@ void UART_sendString(uint8 *str);
  *******************************************************************************/
 void UART_receiveString(uint8 *str);
 
+/******************************************************************************
+ *
+ * Function Name: UART_receiveStringTimeout
+ *
+ * Description: Same as UART_receiveString, the whole string must arrive before
+ * 		the deadline. On timeout str holds the partial string, null terminated.
+ *
+ * Args:
+ *
+ * 		[in] const Timeout_DeadlineType *a_deadline
+ * 			Deadline, TIMEOUT_FOREVER to wait without bound
+ * 		[out] uint8 *str
+ * 			Pointer to uint8 array which will contain the received
+ * 			string from UART
+ * Returns: Timeout_StatusType
+ *
+ *******************************************************************************/
+Timeout_StatusType UART_receiveStringTimeout(uint8 *str,
+		const Timeout_DeadlineType *a_deadline);
+
 /******************************************************************************
  *
  * Function Name: UART_set...Callback_Notif
@@ -172,4 +252,25 @@ void UART_receiveString(uint8 *str);
 void UART_setTXCallback_Notif(void (*a_callBackNotif_ptr)(void));
 void UART_setRXCallback_Notif(void (*a_callBackNotif_ptr)(void));
 void UART_setUDRECallback_Notif(void (*a_callBackNotif_ptr)(void));
+
+/******************************************************************************
+ *
+ * Function Name: UART_setIdleCallback_Notif
+ *
+ * Description: Sets a function which is called repeatedly while UART_receiveByte
+ * 		polls for a byte, so background work (e.g. EEPROM flushing) can run
+ * 		while the application waits for the other ECU.
+ * 		---Note: The callback must return quickly, a byte is only read after
+ * 				 it returns.
+ *
+ * Args:
+ *
+ * 		[in] void (*a_callBackNotif_ptr)(void)
+ * 			Pointer to idle function, NULL_PTR to disable
+ * 		[out] N/A
+ *
+ * Returns: void
+ *
+ *******************************************************************************/
+void UART_setIdleCallback_Notif(void (*a_callBackNotif_ptr)(void));
 #endif /* UART_H_ */